@@ -107,6 +107,10 @@ namespace graphene { namespace app {
        {
           _asset_api = std::make_shared< asset_api >( std::ref( *_app.chain_database() ) );
        }
+       else if( api_name == "performance_api" )
+       {
+          _performance_api = std::make_shared< performance_api >( std::ref( *_app.chain_database() ) );
+       }
        else if( api_name == "debug_api" )
        {
           // can only enable this API if the plugin was loaded
@@ -265,6 +269,12 @@ namespace graphene { namespace app {
        return *_asset_api;
     }
 
+    fc::api<performance_api> login_api::performance() const
+    {
+       FC_ASSERT(_performance_api);
+       return *_performance_api;
+    }
+
     fc::api<graphene::debug_witness::debug_api> login_api::debug() const
     {
        FC_ASSERT(_debug_api);
@@ -462,6 +472,8 @@ namespace graphene { namespace app {
                   break;
                  case impl_word_object_type:
                   break;
+                 case impl_coin_price_bucket_type:
+                  break;
           }
        }
        return result;
@@ -694,29 +706,18 @@ namespace graphene { namespace app {
     vector<account_asset_balance> asset_api::get_asset_holders( asset_id_type asset_id, uint32_t start, uint32_t limit ) const {
       FC_ASSERT(limit <= 100);
 
-      const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
-      auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
+      const auto& bal_idx = dynamic_cast<const primary_index<account_balance_index>&>( _db.get_index_type<account_balance_index>() );
+      const auto& holders = bal_idx.get_secondary_index<asset_holder_index>();
 
       vector<account_asset_balance> result;
-
-      uint32_t index = 0;
-      for( const account_balance_object& bal : boost::make_iterator_range( range.first, range.second ) )
+      for( const auto& h : holders.get_holders( asset_id, start, limit ) )
       {
-        if( result.size() >= limit )
-            break;
-
-        if( bal.balance.value == 0 )
-            continue;
-
-        if( index++ < start )
-            continue;
-
-        const auto account = _db.find(bal.owner);
+        const auto& account = h.owner(_db);
 
         account_asset_balance aab;
-        aab.name       = account->name;
-        aab.account_id = account->id;
-        aab.amount     = bal.balance.value;
+        aab.name       = account.name;
+        aab.account_id = account.id;
+        aab.amount     = h.balance.value;
 
         result.push_back(aab);
       }
@@ -726,34 +727,21 @@ namespace graphene { namespace app {
     // get number of asset holders.
     int asset_api::get_asset_holders_count( asset_id_type asset_id ) const {
 
-      const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
-      auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
-
-      int count = boost::distance(range) - 1;
-
-      return count;
+      const auto& bal_idx = dynamic_cast<const primary_index<account_balance_index>&>( _db.get_index_type<account_balance_index>() );
+      return bal_idx.get_secondary_index<asset_holder_index>().holder_count( asset_id );
     }
     // function to get vector of system assets with holders count.
     vector<asset_holders> asset_api::get_all_asset_holders() const {
 
       vector<asset_holders> result;
 
-      vector<asset_id_type> total_assets;
+      const auto& bal_idx = dynamic_cast<const primary_index<account_balance_index>&>( _db.get_index_type<account_balance_index>() );
+      const auto& holders = bal_idx.get_secondary_index<asset_holder_index>();
       for( const asset_object& asset_obj : _db.get_index_type<asset_index>().indices() )
       {
-        const auto& dasset_obj = asset_obj.dynamic_asset_data_id(_db);
-
-        asset_id_type asset_id;
-        asset_id = dasset_obj.id;
-
-        const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
-        auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
-
-        int count = boost::distance(range) - 1;
-
         asset_holders ah;
-        ah.asset_id       = asset_id;
-        ah.count     = count;
+        ah.asset_id = asset_obj.id;
+        ah.count    = holders.holder_count( asset_obj.id );
 
         result.push_back(ah);
       }
@@ -761,4 +749,33 @@ namespace graphene { namespace app {
       return result;
     }
 
+    // performance_api
+    performance_api::performance_api(graphene::chain::database& db) : _db(db) { }
+
+    performance_report performance_api::get_performance_stats()const
+    {
+       const performance_stats& stats = _db.get_performance_stats();
+       performance_report result;
+       for( size_t i = 0; i < stats.operations.size(); ++i )
+          if( stats.operations[i].evaluate.count > 0 )
+             result.operations.emplace_back( operation_type_name( int(i) ), stats.operations[i] );
+       std::sort( result.operations.begin(), result.operations.end(),
+                  []( const pair<string, operation_stats>& a, const pair<string, operation_stats>& b ) {
+                     return a.second.evaluate.total_us + a.second.apply.total_us
+                          > b.second.evaluate.total_us + b.second.apply.total_us;
+                  } );
+       result.blocks = stats.blocks;
+       return result;
+    }
+
+    void performance_api::reset_performance_stats()
+    {
+       _db.reset_performance_stats();
+    }
+
+    void performance_api::set_performance_stats_enabled( bool enabled )
+    {
+       _db.get_performance_stats().enabled = enabled;
+    }
+
 } } // graphene::app
@@ -231,6 +231,9 @@ namespace detail {
 
          wsc->register_api(login->database());
          wsc->register_api(fc::api<graphene::app::login_api>(login));
+         // clients asking for it get database_api results packed with fc::raw in binary frames
+         if( c->get_request_header("X-Api-Encoding") == "raw" )
+            wsc->register_raw_api( "database", login->database() );
          c->set_session_data( wsc );
 
          std::string username = "*";
@@ -374,6 +377,13 @@ namespace detail {
             }
          }
          _chain_db->add_checkpoints( loaded_checkpoints );
+         _chain_db->set_mmap_block_log( _options->count("mmap-block-log") && _options->at("mmap-block-log").as<bool>() );
+         if( _options->count("block-cache-size") )
+            _chain_db->set_block_cache_size( _options->at("block-cache-size").as<uint32_t>() );
+         if( _options->count("perf-stats-dump-blocks") )
+            _chain_db->set_performance_dump_interval( _options->at("perf-stats-dump-blocks").as<uint32_t>() );
+         if( _options->count("api-read-threads") )
+            _chain_db->set_read_worker_threads( _options->at("api-read-threads").as<uint32_t>() );
 
          bool replay = false;
          std::string replay_reason = "reason not provided";
@@ -658,6 +668,18 @@ namespace detail {
         // ilog("Request for item ${id}", ("id", id));
          if( id.item_type == graphene::net::block_message_type )
          {
+            // a block_message is the packed block followed by its id, recent blocks are already packed
+            if( auto packed = _chain_db->fetch_packed_block_by_id(id.item_hash) )
+            {
+               message msg;
+               msg.msg_type = graphene::net::block_message_type;
+               msg.data.reserve( packed->size() + sizeof(block_id_type) );
+               msg.data.insert( msg.data.end(), packed->begin(), packed->end() );
+               auto packed_id = fc::raw::pack( block_id_type(id.item_hash) );
+               msg.data.insert( msg.data.end(), packed_id.begin(), packed_id.end() );
+               msg.size = (uint32_t)msg.data.size();
+               return msg;
+            }
             auto opt_block = _chain_db->fetch_block_by_id(id.item_hash);
             if( !opt_block )
                elog("Couldn't find block ${id} -- corresponding ID in our chain is ${id2}",
@@ -957,6 +979,10 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("genesis-json", bpo::value<boost::filesystem::path>(), "File to read Genesis State from")
          ("dbg-init-key", bpo::value<string>(), "Block signing key to use for init witnesses, overrides genesis file")
          ("api-access", bpo::value<boost::filesystem::path>(), "JSON file specifying API permissions")
+         ("mmap-block-log", bpo::value<bool>()->default_value(false), "Serve block lookups from memory-mapped block log files")
+         ("block-cache-size", bpo::value<uint32_t>()->default_value(GRAPHENE_DEFAULT_BLOCK_CACHE_SIZE), "Number of recent serialized blocks kept in memory for peers and API clients, 0 to disable")
+         ("perf-stats-dump-blocks", bpo::value<uint32_t>()->default_value(0), "Log evaluator and block apply timings every N blocks, 0 to disable")
+         ("api-read-threads", bpo::value<uint32_t>()->default_value(0), "Threads that serve read-only database API queries off the block applying thread, 0 to disable")
          ;
    command_line_options.add(configuration_file_options);
    command_line_options.add_options()
@@ -23,9 +23,9 @@
  */
 
 #include <graphene/app/database_api.hpp>
+#include <graphene/app/subscription_hub.hpp>
 #include <graphene/chain/get_config.hpp>
 
-#include <fc/bloom_filter.hpp>
 #include <fc/smart_ref_impl.hpp>
 
 #include <fc/crypto/hex.hpp>
@@ -35,6 +35,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include <cctype>
+#include <mutex>
 
 #include <cfenv>
 #include <iostream>
@@ -45,6 +46,7 @@
 #define MAX_TOKEN_NUM_FOR_QUERY_RESULTS 30
 #define MAX_BUY_TOKEN_RECORD_NUM_FOR_QUERY_RESULTS 100
 #define MAX_GET_BUY_LIST_RECORD_NUM 100000
+#define API_ERROR_LOGS_PER_SECOND 10
 
 typedef std::map< std::pair<graphene::chain::asset_id_type, graphene::chain::asset_id_type>, std::vector<fc::variant> > market_queue_type;
 
@@ -87,6 +89,10 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       void set_pending_transaction_callback( std::function<void(const variant&)> cb );
       void set_block_applied_callback( std::function<void(const variant& block_id)> cb );
       void cancel_all_subscriptions();
+      void subscribe_to_object_type( uint8_t space, uint8_t type );
+      void unsubscribe_from_object_type( uint8_t space, uint8_t type );
+      void subscribe_to_accounts( const vector<account_id_type>& accounts );
+      void unsubscribe_from_accounts( const vector<account_id_type>& accounts );
 
       // Blocks and transactions
       optional<block_header> get_block_header(uint32_t block_num)const;
@@ -191,6 +197,17 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 
       std::vector<subject_event_object> get_subject_events_by_subject_id( uint32_t start, uint32_t limit, subject_id_type subject_id )const;
       std::vector<subject_event_object> get_subject_events_by_operator( uint32_t start, uint32_t limit, account_id_type operator_id )const;
+
+      query_page<subject_object> get_subjects_by_status_page( subject_object::subject_status status, const optional<query_cursor>& cursor, uint32_t limit )const;
+      query_page<subject_vote_object> get_subject_votes_by_voter_page( const string& account_name_or_id, const optional<query_cursor>& cursor, uint32_t limit )const;
+      query_page<subject_vote_object> get_subject_votes_by_subject_id_page( subject_id_type subject_id, const optional<query_cursor>& cursor, uint32_t limit )const;
+      query_page<full_subject_vote_object> get_my_create_subjects_page( const query_condition &condition, const optional<query_cursor>& cursor )const;
+      query_page<full_subject_vote_object> market_get_subjects_page( const query_condition &condition, const optional<query_cursor>& cursor )const;
+      query_page<full_subject_vote_object> my_get_subjects_page( const query_condition &condition, const optional<query_cursor>& cursor )const;
+      query_page<full_subject_vote_object> get_subjects_by_creator_page( const query_condition &condition, const string &creator_name_or_id, const optional<query_cursor>& cursor )const;
+      query_page<token_brief> get_tokens_brief_page( const token_query_condition &condition, const optional<query_cursor>& cursor )const;
+      query_page<token_brief> my_get_tokens_brief_page( const token_query_condition &condition, const optional<query_cursor>& cursor )const;
+      query_page<token_buy_object> get_buy_list_page( object_id_type token_id, const string &issue_account, const optional<query_cursor>& cursor, uint32_t limit )const;
 	  //[lilianwen add 2017-10-24]
 	  std::vector<full_subject_vote_object> get_my_create_subjects(const query_condition &condition)const;
 	  std::vector<full_subject_vote_object> market_get_subjects(const query_condition &condition)const;
@@ -224,8 +241,11 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 	  //account_name_or_id用来传入项目创建者的账号或者id，只有项目的创建者才能成功调用这个接口
 	  vector<token_buy_object> get_buy_list(uint32_t start, uint32_t limit, object_id_type token_id, const string &issue_account)const;
 	  
+	  //account对subject_id的所有投票，按投票id排序
+	  vector<object_id_type> get_subject_vote_ids(account_id_type voter, subject_id_type subject_id)const;
 	  optional<token_brief> get_token_brief_by_symbol_or_id_impl(const string &token_symbol_or_id, const string &my_account,  query_token_type type)const;
-	  std::vector<token_brief> get_tokens_brief_impl(const token_query_condition &condition, query_token_type type)const;
+	  query_page<token_brief> get_tokens_brief_impl(const token_query_condition &condition, query_token_type type, const optional<query_cursor> &cursor)const;
+	  query_page<token_buy_object> get_buy_list_impl(uint32_t start, uint32_t limit, object_id_type token_id, const string &issue_account, bool paged, const optional<query_cursor> &cursor)const;
 	  void TokenFillExtendField(const set<string> &ext_field,map<string, string> &ret_ext_field)const;
 	  //[end]
 
@@ -235,250 +255,191 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 	  //[lilianwen add 2017-10-31]
 	  template<typename T>
 	  std::vector<full_subject_vote_object> get_subjects(const query_condition &condition, query_subject_type type, account_id_type creator_id=object_id_type(0,0,0))const
+	  {
+		  return get_subjects_page<T>(condition, type, creator_id, optional<query_cursor>()).items;
+	  }
+
+	  //cursor为空时按condition.start跳过前面的记录，否则从cursor之后继续查询
+	  template<typename T>
+	  query_page<full_subject_vote_object> get_subjects_page(const query_condition &condition, query_subject_type type, account_id_type creator_id, const optional<query_cursor> &cursor)const
 	  {
 		  //打印传入参数
-		  elog("start [${start}] , limit[${limit}]", ("start", condition.start)("limit", condition.limit));
-		  elog("start time[${stime}] , end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
-		  elog("direction [${direction}] , order_by[${order_by}]", ("direction", condition.direction)("order_by", condition.order_by));
-		  elog("quote_base [${quote_base}] , status[${status}] , platform_id[${platform_id}] ", ("quote_base", condition.platform_quote_base.quote_base)("status", condition.status)("platform_id", condition.platform_quote_base.platform_id));
-		  elog("account_name_or_id [${account_name_or_id}] ", ("account_name_or_id", condition.account_name_or_id));
-		  elog("creator_id [${creator_id}] ", ("creator_id", creator_id));
+		  tlog("start [${start}] , limit[${limit}]", ("start", condition.start)("limit", condition.limit));
+		  tlog("start time[${stime}] , end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
+		  tlog("direction [${direction}] , order_by[${order_by}]", ("direction", condition.direction)("order_by", condition.order_by));
+		  tlog("quote_base [${quote_base}] , status[${status}] , platform_id[${platform_id}] ", ("quote_base", condition.platform_quote_base.quote_base)("status", condition.status)("platform_id", condition.platform_quote_base.platform_id));
+		  tlog("account_name_or_id [${account_name_or_id}] ", ("account_name_or_id", condition.account_name_or_id));
+		  tlog("creator_id [${creator_id}] ", ("creator_id", creator_id));
 
 		  uint32_t count = 0;
 		  uint32_t index = 1;
 		  uint32_t num = condition.limit <= MAX_SUBJECT_NUM_FOR_QUERY_RESULTS ? condition.limit : MAX_SUBJECT_NUM_FOR_QUERY_RESULTS;
-		  std::vector<full_subject_vote_object> results; results.reserve(num);
+		  query_page<full_subject_vote_object> page; page.items.reserve(num);
 
 		  if (condition.start_time > condition.end_time)
 		  {
-			  elog("start time[${stime}] is larger than end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
-			  return results;
+			  elog_limited(API_ERROR_LOGS_PER_SECOND, "start time[${stime}] is larger than end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
+			  return page;
 		  }
 
 		  const auto &idx = _db.get_index_type<subject_index>().indices().get<T>();
-		  if(idx.size() == 0) return results;
+		  if(idx.size() == 0 || num == 0) return page;
+
+		  //查看当前账户是否投过票
+		  const account_object* account = nullptr;
+		  if ( condition.account_name_or_id == "" || condition.account_name_or_id == "null" )
+		  {
+			  elog_limited(API_ERROR_LOGS_PER_SECOND, "account name or id [${account}] is empty.", ("account",condition.account_name_or_id) );
+		  }
+		  else if (std::isdigit(condition.account_name_or_id[0]))
+			  account = _db.find(fc::variant(condition.account_name_or_id).as<account_id_type>());
+		  else
+		  {
+			  const auto& idx_account = _db.get_index_type<account_index>().indices().get<by_name>();
+			  auto itr = idx_account.find(condition.account_name_or_id);//如果这里为字符串null的话会导致程序崩溃
+			  if (itr != idx_account.end())
+				  account = &*itr;
+		  }
+
+		  auto visit = [&](const subject_object& subject)
+		  {
+			  if ( condition.status != "all" )
+			  {
+				  if (condition.status == "create_status" && (subject.status != subject_object::create_status && subject.status != subject_object::vote_begin_status)) return;
+				  if (condition.status == "vote_end_status" && subject.status != subject_object::vote_end_status ) return;
+				  if (condition.status == "predition_status" && (subject.status != subject_object::judge_status && subject.status != subject_object::settle_status 
+					  && subject.status != subject_object::close_status && subject.status != subject_object::restore_status)) return;
+			  }
+			  if ( condition.platform_quote_base.platform_id !="0000000" && subject.template_subject.unit.platform_id != condition.platform_quote_base.platform_id ) return;
+			  if ( condition.platform_quote_base.quote_base !="ALL" && subject.template_subject.unit.quote_base != condition.platform_quote_base.quote_base ) return;
+			  if ( type == query_subjects_by_creator && subject.creator != creator_id) return;
+			  if ( type == my_create_subjects && account != nullptr && subject.creator != account->id ) return;
+
+			  full_subject_vote_object one;
+			  one.description      = subject.description;
+			  one.template_subject = subject.template_subject;
+			  one.feed_price_result= subject.feed_price_result;
+			  one.result           = subject.result_subject;
+			  one.status           = subject.status;
+			  one.status_expires   = subject.status_expires;
+			  one.subject_id       = subject.id;
+			  one.statistics       = subject.statistics;
+			  one.subject_creator  = _db.find(subject.creator)->name;
+			  tlog("subject creator [${creator_name}] ", ("creator_name", one.subject_creator));
+			  one.article_url      = subject.article_url;
+			  one.deferred_fee     = subject.deferred_fee;
+
+			  //根据subject.statistics查找投票统计的动态信息
+			  subject_statistics_object* vote_statistics = (subject_statistics_object*)_db.find_object(subject.statistics);
+			  if (vote_statistics == NULL)//主题创建了，但是还没有投票
+			  {
+				  elog_limited(API_ERROR_LOGS_PER_SECOND, "subject statistics id ${id} is not found.", ("id", subject.statistics));
+			  }
+			  else
+			  {
+				  one.total           = vote_statistics->total;
+				  one.funds           = vote_statistics->funds;
+			  }
+
+			  bool bMeInvolved = false;
+			  if (account != nullptr)
+			  {
+				  one.subject_vote_id = get_subject_vote_ids(account->id, subject.id);
+				  if ( !one.subject_vote_id.empty() && (type == my_subjects_query || type == my_create_subjects) )
+					  bMeInvolved = true;
+			  }
+
+			  if (type == market_subjects_query || type == query_subjects_by_creator || bMeInvolved)
+			  {
+				  page.items.push_back(one);
+				  ++count;
+			  }
+		  };
+
 		  if (condition.direction == 1)
 		  {
 			  auto itr     = idx.lower_bound(condition.start_time);
 			  auto itr_end = idx.upper_bound(condition.end_time);
-			  for(;itr != itr_end;itr++, index++)
+			  if (cursor.valid())
+			  {
+				  time_point_sec key = cursor_key(idx, *cursor);
+				  if (key > condition.end_time) return page;
+				  if (key >= condition.start_time)
+					  itr = idx.upper_bound(boost::make_tuple(key, cursor->id));
+			  }
+			  for(;itr != itr_end && count < num;itr++, index++)
 			  {
-				  if(index >= condition.start)
+				  if(cursor.valid() || index >= condition.start)
 				  {
-					  if ( condition.status != "all" )
-					  {
-						  if (condition.status == "create_status" && (itr->status != subject_object::create_status && itr->status != subject_object::vote_begin_status)) continue;
-						  if (condition.status == "vote_end_status" && itr->status != subject_object::vote_end_status ) continue;
-						  if (condition.status == "predition_status" && (itr->status != subject_object::judge_status && itr->status != subject_object::settle_status 
-							  && itr->status != subject_object::close_status && itr->status != subject_object::restore_status)) continue;
-					  }
-					 
-					  if ( condition.platform_quote_base.platform_id !="0000000" && itr->template_subject.unit.platform_id != condition.platform_quote_base.platform_id ) continue;	
-					  if ( condition.platform_quote_base.quote_base !="ALL" && itr->template_subject.unit.quote_base != condition.platform_quote_base.quote_base ) continue;	
-					  if ( type == query_subjects_by_creator && itr->creator != creator_id) continue;
-					  full_subject_vote_object one;
-
-					  one.description      = itr->description;
-					  one.template_subject = itr->template_subject;
-					  one.feed_price_result= itr->feed_price_result;
-					  one.result           = itr->result_subject;
-					  one.status           = itr->status;
-					  one.status_expires   = itr->status_expires;
-					  one.subject_id       = itr->id;
-					  one.statistics       = itr->statistics;
-					  one.subject_creator  = _db.find(itr->creator)->name;
-					  elog("subject creator [${creator_name}] ", ("creator_name", one.subject_creator));
-					  one.article_url      = itr->article_url;
-					  one.deferred_fee     = itr->deferred_fee;
-					  
-
-					  //根据itr->statistics查找投票统计的动态信息
-					  subject_statistics_object* vote_statistics = (subject_statistics_object*)_db.find_object(itr->statistics);
-					  if (vote_statistics == NULL)//主题创建了，但是还没有投票
-					  {
-						  elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
-						  //one.total = 0;
-						  //one.funds = 0;
-					  }
-					  else
-					  {
-						  one.total           = vote_statistics->total;
-						  one.funds           = vote_statistics->funds;
-					  }
-
-					  //查看当前账户是否投过票
-					  bool bMeInvolved = false;
-					  one.subject_vote_id.clear();
-					  if ( condition.account_name_or_id == "" || condition.account_name_or_id == "null" )
-					  {
-						  elog("account name or id [${account}] is empty.", ("account",condition.account_name_or_id) );
-						  //one.subject_vote_id = optional<object_id_type>();
-					  }
-					  else
-					  {
-						  const account_object* account = nullptr;
-						  if (std::isdigit(condition.account_name_or_id[0]))
-							  account = _db.find(fc::variant(condition.account_name_or_id).as<account_id_type>());
-						  else
-						  {
-							  const auto& idx = _db.get_index_type<account_index>().indices().get<by_name>();
-							  auto itr = idx.find(condition.account_name_or_id);//如果这里为字符串null的话会导致程序崩溃
-							  if (itr != idx.end())
-								  account = &*itr;
-						  }
-						  if (account == nullptr)
-							  //one.subject_vote_id = optional<object_id_type>();
-							  ;
-						  else
-						  {
-							  if ( type == my_create_subjects && itr->creator != account->id ) continue;
-							  const auto& idx_vote = _db.get_index_type<subject_vote_index>().indices().get<by_id>();
-							  auto itr_vote = idx_vote.begin();
-
-							  for(;itr_vote != idx_vote.end(); itr_vote++)
-							  {
-								  if(itr_vote->voter == account->id && itr_vote->subject_id == one.subject_id)
-								  {
-									  one.subject_vote_id.push_back(itr_vote->id);
-									  if ( type == my_subjects_query || type == my_create_subjects)
-									  {
-										  bMeInvolved = true;
-									  }
-									  //break;
-								  }
-							  }
-						  }
-					  }
-
-					  if (type == market_subjects_query || type == query_subjects_by_creator || bMeInvolved)
-					  {
-						  results.push_back(one);
-						  ++count;
-					  }
-
-					  if (count >= num) break; 
-				  }  
+					  visit(*itr);
+					  if (count >= num && std::next(itr) != itr_end)
+						  page.next = make_cursor(idx, *itr);
+				  }
 			  }
-
-			  return results;
 		  }
 		  else
 		  {
-			  auto itr     = idx.upper_bound(condition.end_time);
-			  auto itr_end = idx.lower_bound(condition.start_time);
-			  if (itr_end == idx.end())
+			  auto itr_begin = idx.lower_bound(condition.start_time);
+			  auto itr       = idx.upper_bound(condition.end_time);
+			  if (cursor.valid())
 			  {
-				  return results;	
+				  time_point_sec key = cursor_key(idx, *cursor);
+				  if (key < condition.start_time) return page;
+				  if (key <= condition.end_time)
+					  itr = idx.lower_bound(boost::make_tuple(key, cursor->id));
 			  }
-			  itr--;
-
-			  for(;true;itr--, index++)
+			  for(;itr != itr_begin && count < num;index++)
 			  {
-				  if(index >= condition.start)
+				  itr--;
+				  if(cursor.valid() || index >= condition.start)
 				  {
-					  if ( condition.status != "all" )
-					  {
-						  if (condition.status == "create_status" && (itr->status != subject_object::create_status && itr->status != subject_object::vote_begin_status)) goto end_contdition;
-						  if (condition.status == "vote_end_status" && itr->status != subject_object::vote_end_status ) goto end_contdition;
-						  if (condition.status == "predition_status" && (itr->status != subject_object::judge_status && itr->status != subject_object::settle_status 
-							  && itr->status != subject_object::close_status && itr->status != subject_object::restore_status)) goto end_contdition;
-					  }
-					  if ( condition.platform_quote_base.platform_id !="0000000" && itr->template_subject.unit.platform_id != condition.platform_quote_base.platform_id ) goto end_contdition;	
-					  if ( condition.platform_quote_base.quote_base !="ALL" && itr->template_subject.unit.quote_base != condition.platform_quote_base.quote_base ) goto end_contdition;	
-					  if ( type == query_subjects_by_creator && itr->creator != creator_id) goto end_contdition;
-					  
-					  full_subject_vote_object one;
-					  one.description      = itr->description;
-					  one.template_subject = itr->template_subject;
-					  one.feed_price_result= itr->feed_price_result;
-					  one.result           = itr->result_subject;
-					  one.status           = itr->status;
-					  one.status_expires   = itr->status_expires;
-					  one.subject_id       = itr->id;
-					  one.statistics       = itr->statistics;
-					  one.subject_creator  = _db.find(itr->creator)->name;
-					  elog("subject creator [${creator_name}] ", ("creator_name", one.subject_creator));
-					  one.article_url      = itr->article_url;
-					  one.deferred_fee     = itr->deferred_fee;
-
-					  //根据itr->statistics查找投票统计的动态信息
-					  subject_statistics_object* vote_statistics = (subject_statistics_object*)_db.find_object(itr->statistics);
-					  if (vote_statistics == NULL)//主题创建了，但是还没有投票
-					  {
-						  elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
-						  //one.total = 0;
-						  //one.funds = 0;
-					  }
-					  else
-					  {
-						  one.total           = vote_statistics->total;
-						  one.funds           = vote_statistics->funds;
-					  }
-
-					  //查看当前账户是否投过票
-					  bool bMeInvolved = false;
-					  one.subject_vote_id.clear();
-					  if ( condition.account_name_or_id == "" || condition.account_name_or_id == "null" )
-					  {
-						  elog("account name or id [${account}] is empty.", ("account",condition.account_name_or_id) );
-						  //one.subject_vote_id = optional<object_id_type>();
-					  }
-					  else
-					  {
-						  const account_object* account = nullptr;
-						  if (std::isdigit(condition.account_name_or_id[0]))
-							  account = _db.find(fc::variant(condition.account_name_or_id).as<account_id_type>());
-						  else
-						  {
-							  const auto& idx = _db.get_index_type<account_index>().indices().get<by_name>();
-							  auto itr = idx.find(condition.account_name_or_id);//如果这里为字符串null的话会导致程序崩溃
-							  if (itr != idx.end())
-								  account = &*itr;
-						  }
-						  if (account == nullptr)
-							  //one.subject_vote_id = optional<object_id_type>();
-							  ;
-						  else
-						  {
-							  if ( type == my_create_subjects && itr->creator != account->id ) goto end_contdition;
-							  const auto& idx_vote = _db.get_index_type<subject_vote_index>().indices().get<by_id>();
-							  auto itr_vote = idx_vote.begin();
-
-							  for(;itr_vote != idx_vote.end(); itr_vote++)
-							  {
-								  if(itr_vote->voter == account->id && itr_vote->subject_id == one.subject_id)
-								  {
-									  one.subject_vote_id.push_back(itr_vote->id);
-									  if ( type == my_subjects_query || type == my_create_subjects)
-									  {
-										  bMeInvolved = true;
-									  }
-									  //break;
-								  }
-							  }
-						  }
-					  }
-
-					  if (type == market_subjects_query || type == query_subjects_by_creator || bMeInvolved)
-					  {
-						  results.push_back(one);
-						  ++count;
-					  }
-
-					  if (count >= num)  break;
-				  } 
-end_contdition:
-				  if (itr == itr_end) break;
+					  visit(*itr);
+					  if (count >= num && itr != itr_begin)
+						  page.next = make_cursor(idx, *itr);
+				  }
 			  }
-				 
-			  return results;
 		  }
+
+		  return page;
+	  }
+
+	  //(key, id)组合索引中obj的排序键和id，下一页从它之后继续
+	  template<typename Index>
+	  static query_cursor make_cursor(const Index &idx, const typename Index::value_type &obj)
+	  {
+		  query_cursor cursor;
+		  cursor.key = fc::variant( boost::tuples::get<0>(idx.key_extractor().key_extractors())(obj) );
+		  cursor.id  = obj.id;
+		  return cursor;
+	  }
+
+	  template<typename Index>
+	  static typename boost::tuples::element<0, typename Index::key_from_value::key_extractor_tuple>::type::result_type
+	  cursor_key(const Index &idx, const query_cursor &cursor)
+	  {
+		  typedef typename boost::tuples::element<0, typename Index::key_from_value::key_extractor_tuple>::type::result_type key_type;
+		  return cursor.key.as<key_type>();
+	  }
+
+	  //在(key, id)组合索引中取出key相同的一页记录
+	  template<typename Index, typename Key>
+	  static query_page<typename Index::value_type> get_page_by_key(const Index &idx, const Key &key, const optional<query_cursor> &cursor, uint32_t limit)
+	  {
+		  query_page<typename Index::value_type> page;
+		  auto itr     = cursor.valid() ? idx.upper_bound(boost::make_tuple(key, cursor->id)) : idx.lower_bound(key);
+		  auto itr_end = idx.upper_bound(key);
+		  for(;itr != itr_end && page.items.size() < limit; itr++)
+			  page.items.push_back(*itr);
+		  if (itr != itr_end && !page.items.empty())
+			  page.next = make_cursor(idx, page.items.back());
+		  return page;
 	  }
 
 	template<typename T>
-	std::vector<token_brief> get_tokens_brief_template_by_statistics_negative(const token_query_condition &condition, query_token_type type)const
+	query_page<token_brief> get_tokens_brief_template_by_statistics_negative(const token_query_condition &condition, query_token_type type, const optional<query_cursor> &cursor)const
 	{
-		std::vector<token_brief> result;
+		query_page<token_brief> page;
+		std::vector<token_brief> &result = page.items;
         if(condition.limit == 0 ) return {};
 		const auto &idx = _db.get_index_type<token_statistics_index>().indices().get<T>();
 		if(idx.size() == 0) return {};
@@ -486,10 +447,13 @@ end_contdition:
 		//考虑end_time 往前推的情况
         uint32_t count=0;
 		auto itr     = idx.end();
+        if (cursor.valid())
+            itr = idx.lower_bound(boost::make_tuple(cursor_key(idx, *cursor), cursor->id));
+        if (itr == idx.begin()) return {};
         itr--;
 		for(;true;itr--)
 		{
-            if(count+1 <= condition.start)
+            if(!cursor.valid() && count+1 <= condition.start)
             {
                 count++;
                 if(itr == idx.begin()) break;
@@ -506,7 +470,7 @@ end_contdition:
             token_object* _token = (token_object*)_db.find_object(one.token_id);
             if (_token == NULL)//主题创建了，但是还没有投票
             {
-                elog("token not found.token id ${id} is not found.", ("id", one.token_id));
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "token not found.token id ${id} is not found.", ("id", one.token_id));
             }
             else
             {
@@ -563,7 +527,7 @@ end_contdition:
             //查看当前账户是否投过票
             if ( condition.my_account == "" || condition.my_account == "null" )
             {
-                elog("account name or id [${account}] is empty.", ("account",condition.my_account) );
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "account name or id [${account}] is empty.", ("account",condition.my_account) );
                 //one.subject_vote_id = optional<object_id_type>();
             }
             else
@@ -586,21 +550,18 @@ end_contdition:
                         one.buy_count++;
                     }
         
-                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-                    auto itr_buy = idx_buy.begin();
-        
-                    for(;itr_buy != idx_buy.end(); itr_buy++)
+                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+                    auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(one.token_id)));
+
+                    for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
                     {
-                        if(itr_buy->buyer == account->id && itr_buy->token_id == one.token_id)
+                        one.buy_count++;
+                        if (type == my_tokens_query)
                         {
-                            one.buy_count++;
-                            if (type == my_tokens_query)
-                            {
-                                one.my_participate.push_back(itr_buy->template_parameter);
-                            }
-                            else
-                                break;
+                            one.my_participate.push_back(itr_buy->template_parameter);
                         }
+                        else
+                            break;
                     }
                 }
             }
@@ -620,28 +581,35 @@ end_contdition:
             }
         
             if(itr == idx.begin()) break;
-            if(result.size() == condition.limit) break;
+            if(result.size() == condition.limit)
+            {
+                page.next = make_cursor(idx, *itr);
+                break;
+            }
 		}
-        return result;		    
+        return page;
 	}
 
     template<typename T>
-    std::vector<token_brief> get_tokens_brief_template_by_global_positive(const token_query_condition &condition, query_token_type type, const string &ext="")const
+    query_page<token_brief> get_tokens_brief_template_by_global_positive(const token_query_condition &condition, query_token_type type, const optional<query_cursor> &cursor, const string &ext="")const
     {
     	if (condition.limit == 0) return {};
         if (condition.start_time > condition.end_time)
         {
-            elog("start time[${stime}] is larger than end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
+            elog_limited(API_ERROR_LOGS_PER_SECOND, "start time[${stime}] is larger than end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
             return {};
         }
 
         const auto &idx = _db.get_index_type<token_index>().indices().get<T>();
         if(idx.size() == 0) return {};
 
-        std::vector<token_brief> result;
+        query_page<token_brief> page;
+        std::vector<token_brief> &result = page.items;
         uint32_t count=0;
         auto itr     = idx.begin();
         auto itr_end = idx.end();
+        if (cursor.valid())
+            itr = idx.upper_bound(boost::make_tuple(cursor_key(idx, *cursor), cursor->id));
         for(;itr != itr_end;itr++)
         {      
             if ( condition.status != "all" )
@@ -667,7 +635,7 @@ end_contdition:
                 }                
             }
             
-            if(count+1 <= condition.start)
+            if(!cursor.valid() && count+1 <= condition.start)
             {
                 count++;
                 continue;
@@ -715,7 +683,7 @@ end_contdition:
             token_statistics_object* token_statistics = (token_statistics_object*)_db.find_object(itr->statistics);
             if (token_statistics == NULL)//主题创建了，但是还没有投票
             {
-                elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "subject statistics id ${id} is not found.", ("id", itr->statistics));
             }
             else
             {
@@ -729,7 +697,7 @@ end_contdition:
             //查看当前账户是否投过票
             if ( condition.my_account == "" || condition.my_account == "null" )
             {
-                elog("account name or id [${account}] is empty.", ("account",condition.my_account) );
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "account name or id [${account}] is empty.", ("account",condition.my_account) );
                 //one.subject_vote_id = optional<object_id_type>();
             }
             else
@@ -752,21 +720,18 @@ end_contdition:
                         one.buy_count++;
                     }
 
-                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-                    auto itr_buy = idx_buy.begin();
+                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+                    auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(one.token_id)));
 
-                    for(;itr_buy != idx_buy.end(); itr_buy++)
+                    for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
                     {
-                        if(itr_buy->buyer == account->id && itr_buy->token_id == one.token_id)
+                        one.buy_count++;
+                        if (type == my_tokens_query)
                         {
-                            one.buy_count++;
-                            if (type == my_tokens_query)
-                            {
-                                one.my_participate.push_back(itr_buy->template_parameter);
-                            }
-                            else
-                                break;
+                            one.my_participate.push_back(itr_buy->template_parameter);
                         }
+                        else
+                            break;
                     }
                 }
             }
@@ -785,29 +750,32 @@ end_contdition:
                 result.push_back(one);
             }
             
-            if(result.size() == condition.limit) break;
+            if(result.size() == condition.limit)
+            {
+                if (std::next(itr) != itr_end)
+                    page.next = make_cursor(idx, *itr);
+                break;
+            }
         }
-        return result;        
+        return page;
     }
 
     template<typename T>
-    std::vector<token_brief> get_tokens_brief_template_by_global_negative(const token_query_condition &condition, query_token_type type, const string &ext="")const
+    query_page<token_brief> get_tokens_brief_template_by_global_negative(const token_query_condition &condition, query_token_type type, const optional<query_cursor> &cursor, const string &ext="")const
     {
-        std::vector<token_brief> result;
+        query_page<token_brief> page;
+        std::vector<token_brief> &result = page.items;
         if (condition.limit ==0) return {};
 
         const auto &idx = _db.get_index_type<token_index>().indices().get<T>();
-        if(idx.size() == 0) return result;
-
-        for(auto itr_test=idx.begin(); itr_test !=idx.end(); itr_test++)
-        {
-        	string issuer_name = _db.find(itr_test->issuer)->name;
-        	elog("token object id is ${token_object_id},issuer is ${issuer}",("token_object_id",itr_test->id)("issuer", issuer_name));
-        }
+        if(idx.size() == 0) return {};
 
         //都是从大到小排序
         uint32_t count=0;
         auto itr = idx.end();
+        if (cursor.valid())
+            itr = idx.lower_bound(boost::make_tuple(cursor_key(idx, *cursor), cursor->id));
+        if (itr == idx.begin()) return {};
         itr--;
         for(;true;itr--)
         {
@@ -844,7 +812,7 @@ end_contdition:
                 }                
             }
             
-            if(count+1 <= condition.start)
+            if(!cursor.valid() && count+1 <= condition.start)
             {
                 count++;
                 if(itr == idx.begin()) break;
@@ -892,11 +860,11 @@ end_contdition:
             token_statistics_object* token_statistics = (token_statistics_object*)_db.find_object(itr->statistics);
             if (token_statistics == NULL)//主题创建了，但是还没有投票
             {
-                elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "subject statistics id ${id} is not found.", ("id", itr->statistics));
             }
             else
             {
-                elog("token id is ${token_id}",("token_id",token_statistics->token_id));
+                tlog("token id is ${token_id}",("token_id",token_statistics->token_id));
                 one.token_id                   = token_statistics->token_id;
                 one.actual_buy_amount          = token_statistics->actual_buy_total;//所有参与的用户已经认购的用户资产数量，这个考虑一下怎么算
                 one.actual_core_asset_total    = token_statistics->actual_core_asset_total;//所有参与的用户已经募集的AFT数量
@@ -907,7 +875,7 @@ end_contdition:
             //查看当前账户是否投过票
             if ( condition.my_account == "" || condition.my_account == "null" )
             {
-                elog("account name or id [${account}] is empty.", ("account",condition.my_account) );
+                elog_limited(API_ERROR_LOGS_PER_SECOND, "account name or id [${account}] is empty.", ("account",condition.my_account) );
                 //one.subject_vote_id = optional<object_id_type>();
             }
             else
@@ -930,21 +898,18 @@ end_contdition:
                         one.buy_count++;
                     }
 
-                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-                    auto itr_buy = idx_buy.begin();
+                    const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+                    auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(one.token_id)));
 
-                    for(;itr_buy != idx_buy.end(); itr_buy++)
+                    for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
                     {
-                        if(itr_buy->buyer == account->id && itr_buy->token_id == one.token_id)
+                        one.buy_count++;
+                        if (type == my_tokens_query)
                         {
-                            one.buy_count++;
-                            if (type == my_tokens_query)
-                            {
-                                one.my_participate.push_back(itr_buy->template_parameter);
-                            }
-                            else
-                                break;
+                            one.my_participate.push_back(itr_buy->template_parameter);
                         }
+                        else
+                            break;
                     }
                 }
             }
@@ -964,43 +929,30 @@ end_contdition:
             }
 
             if (itr == idx.begin()) break;
-            if (result.size() == condition.limit) break;
+            if (result.size() == condition.limit)
+            {
+                page.next = make_cursor(idx, *itr);
+                break;
+            }
         }  
-        return result;  
+        return page;
     }
 	//[end]
 
-      template<typename T>
-      void subscribe_to_item( const T& i )const
-      {
-         auto vec = fc::raw::pack(i);
-         if( !_subscribe_callback )
-            return;
-
-         if( !is_subscribed_to_item(i) )
-         {
-            idump((i));
-            _subscribe_filter.insert( vec.data(), vec.size() );//(vecconst char*)&i, sizeof(i) );
-         }
-      }
-
-      template<typename T>
-      bool is_subscribed_to_item( const T& i )const
+      /// subscriber of this connection, 0 without a subscribe callback; read calls run on worker threads
+      subscription_hub::subscriber_id active_subscriber()const
       {
-         if( !_subscribe_callback )
-            return false;
-
-         return _subscribe_filter.contains( i );
+         std::lock_guard<std::mutex> guard( _subscribe_lock );
+         return _subscribe_callback ? _subscriber : 0;
       }
 
-      bool is_impacted_account( const flat_set<account_id_type>& accounts)
+      void subscribe_to_item( object_id_type id )const
       {
-         if( !_subscribed_accounts.size() || !accounts.size() )
-            return false;
+         auto subscriber = active_subscriber();
+         if( !subscriber )
+            return;
 
-         return std::any_of(accounts.begin(), accounts.end(), [this](const account_id_type& account) {
-            return _subscribed_accounts.find(account) != _subscribed_accounts.end();
-         });
+         _subscriptions->subscribe_to_object( subscriber, id );
       }
 
       template<typename T>
@@ -1017,26 +969,22 @@ end_contdition:
          }
       }
 
-      void broadcast_updates( const vector<variant>& updates );
       void broadcast_market_updates( const market_queue_type& queue);
-      void handle_object_changed(bool force_notify, bool full_object, const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts, std::function<const object*(object_id_type id)> find_object);
 
-      /** called every time a block is applied to report the objects that were changed */
-      void on_objects_new(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts);
-      void on_objects_changed(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts);
-      void on_objects_removed(const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts);
+      /** called every time a block is applied to report the objects that were changed,
+       *  object subscriptions are served by subscription_hub, this only handles markets */
+      void on_object_changes( const vector<object_change>& changes );
       void on_applied_block();
 
       bool _notify_remove_create = false;
-      mutable fc::bloom_filter _subscribe_filter;
-      std::set<account_id_type> _subscribed_accounts;
+      std::shared_ptr<subscription_hub> _subscriptions;
+      subscription_hub::subscriber_id _subscriber = 0;
       std::function<void(const fc::variant&)> _subscribe_callback;
+      mutable std::mutex                      _subscribe_lock; ///< guards _subscribe_callback and _subscriber
       std::function<void(const fc::variant&)> _pending_trx_callback;
       std::function<void(const fc::variant&)> _block_applied_callback;
 
-      boost::signals2::scoped_connection                                                                                           _new_connection;
       boost::signals2::scoped_connection                                                                                           _change_connection;
-      boost::signals2::scoped_connection                                                                                           _removed_connection;
       boost::signals2::scoped_connection                                                                                           _applied_block_connection;
       boost::signals2::scoped_connection                                                                                           _pending_trx_connection;
       map< pair<asset_id_type,asset_id_type>, std::function<void(const variant&)> >      _market_subscriptions;
@@ -1057,14 +1005,9 @@ database_api::~database_api() {}
 database_api_impl::database_api_impl( graphene::chain::database& db ):_db(db)
 {
    wlog("creating database api ${x}", ("x",int64_t(this)) );
-   _new_connection = _db.new_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_new(ids, impacted_accounts);
-                                });
-   _change_connection = _db.changed_objects.connect([this](const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_changed(ids, impacted_accounts);
-                                });
-   _removed_connection = _db.removed_objects.connect([this](const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts) {
-                                on_objects_removed(ids, objs, impacted_accounts);
+   _subscriptions = subscription_hub::get( _db );
+   _change_connection = _db.object_changes.connect([this](const vector<object_change>& changes) {
+                                on_object_changes(changes);
                                 });
    _applied_block_connection = _db.applied_block.connect([this](const signed_block&){ on_applied_block(); });
 
@@ -1076,6 +1019,8 @@ database_api_impl::database_api_impl( graphene::chain::database& db ):_db(db)
 database_api_impl::~database_api_impl()
 {
    elog("freeing database api ${x}", ("x",int64_t(this)) );
+   if( _subscriber )
+      _subscriptions->remove_subscriber( _subscriber );
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -1086,12 +1031,12 @@ database_api_impl::~database_api_impl()
 
 fc::variants database_api::get_objects(const vector<object_id_type>& ids)const
 {
-   return my->get_objects( ids );
+   return my->_db.with_read_access( [&]() { return my->get_objects( ids ); } );
 }
 
 fc::variants database_api_impl::get_objects(const vector<object_id_type>& ids)const
 {
-   if( _subscribe_callback )  {
+   if( active_subscriber() )  {
       for( auto id : ids )
       {
          if( id.type() == operation_history_object_type && id.space() == protocol_ids ) continue;
@@ -1128,16 +1073,35 @@ void database_api::set_subscribe_callback( std::function<void(const variant&)> c
 void database_api_impl::set_subscribe_callback( std::function<void(const variant&)> cb, bool notify_remove_create )
 {
    //edump((clear_filter));
-   _subscribe_callback = cb;
-   _notify_remove_create = notify_remove_create;
-   _subscribed_accounts.clear();
+   subscription_hub::subscriber_id old_subscriber;
+   {
+      std::lock_guard<std::mutex> guard( _subscribe_lock );
+      _subscribe_callback = cb;
+      _notify_remove_create = notify_remove_create;
+      old_subscriber = _subscriber;
+      _subscriber = 0;
+   }
 
-   static fc::bloom_parameters param;
-   param.projected_element_count    = 10000;
-   param.false_positive_probability = 1.0/100;
-   param.maximum_size = 1024*8*8*2;
-   param.compute_optimal_parameters();
-   _subscribe_filter = fc::bloom_filter(param);
+   if( old_subscriber )
+      _subscriptions->remove_subscriber( old_subscriber );
+   if( cb )
+   {
+      std::weak_ptr<database_api_impl> weak_this = shared_from_this();
+      auto subscriber = _subscriptions->add_subscriber( [weak_this]( const fc::variant& updates ) {
+         auto capture_this = weak_this.lock();
+         if( !capture_this )
+            return;
+         std::function<void(const fc::variant&)> callback;
+         {
+            std::lock_guard<std::mutex> guard( capture_this->_subscribe_lock );
+            callback = capture_this->_subscribe_callback;
+         }
+         if( callback )
+            callback( updates );
+      }, notify_remove_create );
+      std::lock_guard<std::mutex> guard( _subscribe_lock );
+      _subscriber = subscriber;
+   }
 }
 
 void database_api::set_pending_transaction_callback( std::function<void(const variant&)> cb )
@@ -1171,6 +1135,53 @@ void database_api_impl::cancel_all_subscriptions()
    _market_subscriptions.clear();
 }
 
+void database_api::subscribe_to_object_type( uint8_t space, uint8_t type )
+{
+   my->subscribe_to_object_type( space, type );
+}
+
+void database_api_impl::subscribe_to_object_type( uint8_t space, uint8_t type )
+{
+   FC_ASSERT( _subscribe_callback, "set_subscribe_callback must be called first" );
+   _subscriptions->subscribe_to_object_type( _subscriber, space, type );
+}
+
+void database_api::unsubscribe_from_object_type( uint8_t space, uint8_t type )
+{
+   my->unsubscribe_from_object_type( space, type );
+}
+
+void database_api_impl::unsubscribe_from_object_type( uint8_t space, uint8_t type )
+{
+   _subscriptions->unsubscribe_from_object_type( _subscriber, space, type );
+}
+
+void database_api::subscribe_to_accounts( const vector<account_id_type>& accounts )
+{
+   my->subscribe_to_accounts( accounts );
+}
+
+void database_api_impl::subscribe_to_accounts( const vector<account_id_type>& accounts )
+{
+   FC_ASSERT( _subscribe_callback, "set_subscribe_callback must be called first" );
+   for( const auto& account : accounts )
+   {
+      FC_ASSERT( _subscriptions->subscribed_account_count( _subscriber ) <= 100 );
+      _subscriptions->subscribe_to_account( _subscriber, account );
+   }
+}
+
+void database_api::unsubscribe_from_accounts( const vector<account_id_type>& accounts )
+{
+   my->unsubscribe_from_accounts( accounts );
+}
+
+void database_api_impl::unsubscribe_from_accounts( const vector<account_id_type>& accounts )
+{
+   for( const auto& account : accounts )
+      _subscriptions->unsubscribe_from_account( _subscriber, account );
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Blocks and transactions                                          //
@@ -1184,7 +1195,7 @@ optional<block_header> database_api::get_block_header(uint32_t block_num)const
 
 optional<block_header> database_api_impl::get_block_header(uint32_t block_num) const
 {
-   auto result = _db.fetch_block_by_number(block_num);
+   auto result = _db.fetch_block_header_by_number(block_num);
    if(result)
       return *result;
    return {};
@@ -1211,6 +1222,8 @@ optional<signed_block> database_api::get_block(uint32_t block_num)const
 
 optional<signed_block> database_api_impl::get_block(uint32_t block_num)const
 {
+   if( auto packed = _db.fetch_packed_block_by_number(block_num) )
+      return fc::raw::unpack<signed_block>( *packed );
    return _db.fetch_block_by_number(block_num);
 }
 
@@ -1321,13 +1334,6 @@ vector<vector<account_id_type>> database_api_impl::get_key_references( vector<pu
       address a4( pts_address(key, true, 0)  );
       address a5( key );
 
-      subscribe_to_item( key );
-      subscribe_to_item( a1 );
-      subscribe_to_item( a2 );
-      subscribe_to_item( a3 );
-      subscribe_to_item( a4 );
-      subscribe_to_item( a5 );
-
       const auto& idx = _db.get_index_type<account_index>();
       const auto& aidx = dynamic_cast<const primary_index<account_index>&>(idx);
       const auto& refs = aidx.get_secondary_index<graphene::chain::account_member_index>();
@@ -1356,8 +1362,9 @@ vector<vector<account_id_type>> database_api_impl::get_key_references( vector<pu
       final_result.emplace_back( std::move(result) );
    }
 
-   for( auto i : final_result )
-      subscribe_to_item(i);
+   for( const auto& accounts : final_result )
+      for( const auto& account : accounts )
+         subscribe_to_item( account );
 
    return final_result;
 }
@@ -1419,7 +1426,7 @@ vector<optional<account_object>> database_api_impl::get_accounts(const vector<ac
 
 std::map<string,full_account> database_api::get_full_accounts( const vector<string>& names_or_ids, bool subscribe )
 {
-   return my->get_full_accounts( names_or_ids, subscribe );
+   return my->_db.with_read_access( [&]() { return my->get_full_accounts( names_or_ids, subscribe ); } );
 }
 
 std::map<std::string, full_account> database_api_impl::get_full_accounts( const vector<std::string>& names_or_ids, bool subscribe)
@@ -1444,8 +1451,12 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
 
       if( subscribe )
       {
-         FC_ASSERT( std::distance(_subscribed_accounts.begin(), _subscribed_accounts.end()) <= 100 );
-         _subscribed_accounts.insert( account->get_id() );
+         auto subscriber = active_subscriber();
+         if( subscriber )
+         {
+            FC_ASSERT( _subscriptions->subscribed_account_count( subscriber ) <= 100 );
+            _subscriptions->subscribe_to_account( subscriber, account->get_id() );
+         }
          subscribe_to_item( account->id );
       }
 
@@ -1588,7 +1599,7 @@ vector<optional<account_object>> database_api_impl::lookup_account_names(const v
 
 map<string,account_id_type> database_api::lookup_accounts(const string& lower_bound_name, uint32_t limit)const
 {
-   return my->lookup_accounts( lower_bound_name, limit );
+   return my->_db.with_read_access( [&]() { return my->lookup_accounts( lower_bound_name, limit ); } );
 }
 
 map<string,account_id_type> database_api_impl::lookup_accounts(const string& lower_bound_name, uint32_t limit)const
@@ -1627,7 +1638,7 @@ uint64_t database_api_impl::get_account_count()const
 
 vector<asset> database_api::get_account_balances(account_id_type id, const flat_set<asset_id_type>& assets)const
 {
-   return my->get_account_balances( id, assets );
+   return my->_db.with_read_access( [&]() { return my->get_account_balances( id, assets ); } );
 }
 
 vector<asset> database_api_impl::get_account_balances(account_id_type acnt, const flat_set<asset_id_type>& assets)const
@@ -1681,10 +1692,10 @@ vector<balance_object> database_api_impl::get_balance_objects( const vector<addr
 
       for( const auto& owner : addrs )
       {
-         subscribe_to_item( owner );
          auto itr = by_owner_idx.lower_bound( boost::make_tuple( owner, asset_id_type(0) ) );
          while( itr != by_owner_idx.end() && itr->owner == owner )
          {
+            subscribe_to_item( itr->id );
             result.push_back( *itr );
             ++itr;
          }
@@ -1760,7 +1771,7 @@ vector<optional<asset_object>> database_api_impl::get_assets(const vector<asset_
 
 vector<asset_object> database_api::list_assets(const string& lower_bound_symbol, uint32_t limit)const
 {
-   return my->list_assets( lower_bound_symbol, limit );
+   return my->_db.with_read_access( [&]() { return my->list_assets( lower_bound_symbol, limit ); } );
 }
 
 vector<asset_object> database_api_impl::list_assets(const string& lower_bound_symbol, uint32_t limit)const
@@ -1862,7 +1873,7 @@ vector<optional<coin_object>> database_api::lookup_coin_names(const vector<strin
 
 vector<optional<coin_object>> database_api_impl::lookup_coin_names(const vector<string>& names_or_ids)const
 {
-	ilog("lookup coins ${names}", ("names", names_or_ids));
+	tlog("lookup coins ${names}", ("names", names_or_ids));
    const auto& platform_quote_bases = _db.get_index_type<coin_index>().indices().get<by_platform_quote_base>();
 //   ilog("coins_by_name: ${coins}", ("coins", coins_by_name));
    vector<optional<coin_object> > result;
@@ -1881,7 +1892,7 @@ vector<optional<coin_object>> database_api_impl::lookup_coin_names(const vector<
 
    for (auto itr = platform_quote_bases.begin(); itr != platform_quote_bases.end(); ++itr)
    {
-	   ilog("coin: ${coin}", ("coin", *itr));
+	   tlog("coin: ${coin}", ("coin", *itr));
    }
    return result;
 }
@@ -2138,7 +2149,7 @@ market_volume database_api_impl::get_24_volume( const string& base, const string
 
 order_book database_api::get_order_book( const string& base, const string& quote, unsigned limit )const
 {
-   return my->get_order_book( base, quote, limit);
+   return my->_db.with_read_access( [&]() { return my->get_order_book( base, quote, limit); } );
 }
 
 order_book database_api_impl::get_order_book( const string& base, const string& quote, unsigned limit )const
@@ -2197,7 +2208,7 @@ vector<market_trade> database_api::get_trade_history( const string& base,
                                                       fc::time_point_sec stop,
                                                       unsigned limit )const
 {
-   return my->get_trade_history( base, quote, start, stop, limit );
+   return my->_db.with_read_access( [&]() { return my->get_trade_history( base, quote, start, stop, limit ); } );
 }
 
 vector<market_trade> database_api_impl::get_trade_history( const string& base,
@@ -2778,17 +2789,6 @@ vector<blinded_balance_object> database_api_impl::get_blinded_balances( const fl
 //                                                                  //
 //////////////////////////////////////////////////////////////////////
 
-void database_api_impl::broadcast_updates( const vector<variant>& updates )
-{
-   if( updates.size() && _subscribe_callback ) {
-      auto capture_this = shared_from_this();
-      fc::async([capture_this,updates](){
-          if(capture_this->_subscribe_callback)
-            capture_this->_subscribe_callback( fc::variant(updates) );
-      });
-   }
-}
-
 void database_api_impl::broadcast_market_updates( const market_queue_type& queue)
 {
    if( queue.size() )
@@ -2805,82 +2805,28 @@ void database_api_impl::broadcast_market_updates( const market_queue_type& queue
    }
 }
 
-void database_api_impl::on_objects_removed( const vector<object_id_type>& ids, const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts)
-{
-   handle_object_changed(_notify_remove_create, false, ids, impacted_accounts,
-      [objs](object_id_type id) -> const object* {
-         auto it = std::find_if(
-               objs.begin(), objs.end(),
-               [id](const object* o) {return o != nullptr && o->id == id;});
-
-         if (it != objs.end())
-            return *it;
-
-         return nullptr;
-      }
-   );
-}
-
-void database_api_impl::on_objects_new(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts)
-{
-   handle_object_changed(_notify_remove_create, true, ids, impacted_accounts,
-      std::bind(&object_database::find_object, &_db, std::placeholders::_1)
-   );
-}
-
-void database_api_impl::on_objects_changed(const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts)
+void database_api_impl::on_object_changes( const vector<object_change>& changes )
 {
-   handle_object_changed(false, true, ids, impacted_accounts,
-      std::bind(&object_database::find_object, &_db, std::placeholders::_1)
-   );
-}
+   if( _market_subscriptions.empty() )
+      return;
 
-void database_api_impl::handle_object_changed(bool force_notify, bool full_object, const vector<object_id_type>& ids, const flat_set<account_id_type>& impacted_accounts, std::function<const object*(object_id_type id)> find_object)
-{
-   if( _subscribe_callback )
+   market_queue_type broadcast_queue;
+   for( const auto& change : changes )
    {
-      vector<variant> updates;
-
-      for(auto id : ids)
+      if( change.obj == nullptr )
+         continue;
+      bool full_object = change.kind != object_change::removed;
+      if( change.id.is<call_order_object>() )
       {
-         if( force_notify || is_subscribed_to_item(id) || is_impacted_account(impacted_accounts) )
-         {
-            if( full_object )
-            {
-               auto obj = find_object(id);
-               if( obj )
-               {
-                  updates.emplace_back( obj->to_variant() );
-               }
-            }
-            else
-            {
-               updates.emplace_back( id );
-            }
-         }
+         enqueue_if_subscribed_to_market<call_order_object>( change.obj, broadcast_queue, full_object );
       }
-
-      broadcast_updates(updates);
-   }
-
-   if( _market_subscriptions.size() )
-   {
-      market_queue_type broadcast_queue;
-
-      for(auto id : ids)
+      else if( change.id.is<limit_order_object>() )
       {
-         if( id.is<call_order_object>() )
-         {
-            enqueue_if_subscribed_to_market<call_order_object>( find_object(id), broadcast_queue, full_object );
-         }
-         else if( id.is<limit_order_object>() )
-         {
-            enqueue_if_subscribed_to_market<limit_order_object>( find_object(id), broadcast_queue, full_object );
-         }
+         enqueue_if_subscribed_to_market<limit_order_object>( change.obj, broadcast_queue, full_object );
       }
-
-      broadcast_market_updates(broadcast_queue);
    }
+
+   broadcast_market_updates(broadcast_queue);
 }
 
 /** note: this method cannot yield because it is called in the middle of
@@ -2977,7 +2923,7 @@ std::vector<subject_object> database_api_impl::get_subjects_by_name( uint32_t st
    auto itr = idx.begin();
    for(;itr != idx.end(); itr++)
    {
-      ilog("get_subjects_by_name subject_name=${a}, name=${b}", ("a", itr->subject_name)("b", itr->subject_name));
+      tlog("get_subjects_by_name subject_name=${a}, name=${b}", ("a", itr->subject_name)("b", itr->subject_name));
       if (index >= start && itr->subject_name.find(name) != string::npos)
       {
          results.push_back(*itr);
@@ -3034,10 +2980,10 @@ std::vector<subject_object> database_api_impl::get_subjects_by_status( uint32_t
 
    const auto& idx = _db.get_index_type<subject_index>().indices().get<by_subject_status>();
 
-   auto itr = idx.lower_bound(status);
-   for(;itr != idx.end(); itr++)
+   auto range = idx.equal_range(status);
+   for(auto itr = range.first; itr != range.second; itr++, index++)
    {
-      if (index >= start && itr->status == status)
+      if (index >= start)
       {
          results.push_back(*itr);
          ++count;
@@ -3139,11 +3085,11 @@ std::vector<subject_vote_object> database_api_impl::get_subject_votes_by_voter(
       return results;
 
    const auto& idx = _db.get_index_type<subject_vote_index>().indices().get<by_voter>();
-   auto itr = idx.begin();
+   auto range = idx.equal_range(account->id);
 
-   for(;itr != idx.end(); itr++,index++)
+   for(auto itr = range.first; itr != range.second; itr++,index++)
    {
-      if(index >= start && itr->voter == account->id)
+      if(index >= start)
       {
          results.push_back(*itr);
          ++count;
@@ -3170,11 +3116,11 @@ std::vector<subject_vote_object> database_api_impl::get_subject_votes_by_subject
    std::vector<subject_vote_object> results; results.reserve(num);
 
    const auto& idx = _db.get_index_type<subject_vote_index>().indices().get<by_subject_id>();
-   auto itr = idx.begin();
+   auto range = idx.equal_range(subject_id);
 
-   for(;itr != idx.end(); itr++,index++)
+   for(auto itr = range.first; itr != range.second; itr++,index++)
    {
-      if(index >= start && itr->subject_id == subject_id)
+      if(index >= start)
       {
          results.push_back(*itr);
          ++count;
@@ -3248,10 +3194,62 @@ std::vector<subject_event_object> database_api_impl::get_subject_events_by_opera
    return results;
 }
 
+query_page<subject_object> database_api::get_subjects_by_status_page( subject_object::subject_status status, optional<query_cursor> cursor, uint32_t limit )const
+{
+   return my->get_subjects_by_status_page( status, cursor, limit );
+}
+
+query_page<subject_object> database_api_impl::get_subjects_by_status_page( subject_object::subject_status status, const optional<query_cursor>& cursor, uint32_t limit )const
+{
+   uint32_t num = limit <= MAX_SUBJECT_NUM_FOR_QUERY_RESULTS ? limit : MAX_SUBJECT_NUM_FOR_QUERY_RESULTS;
+   const auto& idx = _db.get_index_type<subject_index>().indices().get<by_subject_status>();
+   return get_page_by_key( idx, status, cursor, num );
+}
+
+query_page<subject_vote_object> database_api::get_subject_votes_by_voter_page( string account_name_or_id, optional<query_cursor> cursor, uint32_t limit )const
+{
+   return my->get_subject_votes_by_voter_page( account_name_or_id, cursor, limit );
+}
+
+query_page<subject_vote_object> database_api_impl::get_subject_votes_by_voter_page( const string& account_name_or_id, const optional<query_cursor>& cursor, uint32_t limit )const
+{
+   uint32_t num = limit <= MAX_SUBJECT_NUM_FOR_QUERY_RESULTS ? limit : MAX_SUBJECT_NUM_FOR_QUERY_RESULTS;
+
+   const account_object* account = nullptr;
+   if (account_name_or_id.empty())
+      return query_page<subject_vote_object>();
+   if (std::isdigit(account_name_or_id[0]))
+      account = _db.find(fc::variant(account_name_or_id).as<account_id_type>());
+   else
+   {
+      const auto& idx = _db.get_index_type<account_index>().indices().get<by_name>();
+      auto itr = idx.find(account_name_or_id);
+      if (itr != idx.end())
+         account = &*itr;
+   }
+   if (account == nullptr)
+      return query_page<subject_vote_object>();
+
+   const auto& idx = _db.get_index_type<subject_vote_index>().indices().get<by_voter>();
+   return get_page_by_key( idx, account->id, cursor, num );
+}
+
+query_page<subject_vote_object> database_api::get_subject_votes_by_subject_id_page( subject_id_type subject_id, optional<query_cursor> cursor, uint32_t limit )const
+{
+   return my->get_subject_votes_by_subject_id_page( subject_id, cursor, limit );
+}
+
+query_page<subject_vote_object> database_api_impl::get_subject_votes_by_subject_id_page( subject_id_type subject_id, const optional<query_cursor>& cursor, uint32_t limit )const
+{
+   uint32_t num = limit <= MAX_SUBJECT_NUM_FOR_QUERY_RESULTS ? limit : MAX_SUBJECT_NUM_FOR_QUERY_RESULTS;
+   const auto& idx = _db.get_index_type<subject_vote_index>().indices().get<by_subject_id>();
+   return get_page_by_key( idx, subject_id, cursor, num );
+}
+
 //[lilianwen add 2017-10-24]
 std::vector<full_subject_vote_object> database_api::get_my_create_subjects(const query_condition &condition)const
 {
-	return my->get_my_create_subjects( condition );
+	return my->_db.with_read_access( [&]() { return my->get_my_create_subjects( condition ); } );
 }
 
 std::vector<full_subject_vote_object> database_api_impl::get_my_create_subjects(const query_condition &condition)const
@@ -3259,56 +3257,84 @@ std::vector<full_subject_vote_object> database_api_impl::get_my_create_subjects(
 	return get_subjects<by_creator_time>(condition, my_create_subjects);
 }
 
+query_page<full_subject_vote_object> database_api::get_my_create_subjects_page(const query_condition &condition, optional<query_cursor> cursor)const
+{
+	return my->_db.with_read_access( [&]() { return my->get_my_create_subjects_page( condition, cursor ); } );
+}
+
+query_page<full_subject_vote_object> database_api_impl::get_my_create_subjects_page(const query_condition &condition, const optional<query_cursor>& cursor)const
+{
+	return get_subjects_page<by_creator_time>(condition, my_create_subjects, object_id_type(0,0,0), cursor);
+}
+
 std::vector<full_subject_vote_object> database_api::market_get_subjects(const query_condition &condition)const
 {
-	return my->market_get_subjects( condition );
+	return my->_db.with_read_access( [&]() { return my->market_get_subjects( condition ); } );
 }
 std::vector<full_subject_vote_object> database_api_impl::market_get_subjects(const query_condition &condition)const
+{
+	return market_get_subjects_page(condition, optional<query_cursor>()).items;
+}
+
+query_page<full_subject_vote_object> database_api::market_get_subjects_page(const query_condition &condition, optional<query_cursor> cursor)const
+{
+	return my->_db.with_read_access( [&]() { return my->market_get_subjects_page( condition, cursor ); } );
+}
+
+query_page<full_subject_vote_object> database_api_impl::market_get_subjects_page(const query_condition &condition, const optional<query_cursor>& cursor)const
 {
 	if (condition.order_by == "vote_end_time")
 	{
-		return get_subjects<by_vote_end_time>(condition, market_subjects_query);
+		return get_subjects_page<by_vote_end_time>(condition, market_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else if (condition.order_by == "prediction_end_time")
 	{
-		return get_subjects<by_prediction_end_time>(condition, market_subjects_query);
+		return get_subjects_page<by_prediction_end_time>(condition, market_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else if (condition.order_by == "create_time")
 	{
-		return get_subjects<by_creator_time>(condition, market_subjects_query);
+		return get_subjects_page<by_creator_time>(condition, market_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else
 	{
-		elog("condition order by [${order}] is not support.", ("order", condition.order_by));
-		std::vector<full_subject_vote_object> results;
-		return results;
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "condition order by [${order}] is not support.", ("order", condition.order_by));
+		return query_page<full_subject_vote_object>();
 	}
 }
 
 std::vector<full_subject_vote_object> database_api::my_get_subjects(const query_condition &condition)const
 {
-	return my->my_get_subjects( condition );
+	return my->_db.with_read_access( [&]() { return my->my_get_subjects( condition ); } );
 }
 
 std::vector<full_subject_vote_object> database_api_impl::my_get_subjects(const query_condition &condition)const
+{
+	return my_get_subjects_page(condition, optional<query_cursor>()).items;
+}
+
+query_page<full_subject_vote_object> database_api::my_get_subjects_page(const query_condition &condition, optional<query_cursor> cursor)const
+{
+	return my->_db.with_read_access( [&]() { return my->my_get_subjects_page( condition, cursor ); } );
+}
+
+query_page<full_subject_vote_object> database_api_impl::my_get_subjects_page(const query_condition &condition, const optional<query_cursor>& cursor)const
 {
 	if (condition.order_by == "vote_end_time")
 	{
-		return get_subjects<by_vote_end_time>(condition, my_subjects_query);
+		return get_subjects_page<by_vote_end_time>(condition, my_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else if (condition.order_by == "prediction_end_time")
 	{
-		return get_subjects<by_prediction_end_time>(condition, my_subjects_query);
+		return get_subjects_page<by_prediction_end_time>(condition, my_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else if (condition.order_by == "create_time")
 	{
-		return get_subjects<by_creator_time>(condition, my_subjects_query);
+		return get_subjects_page<by_creator_time>(condition, my_subjects_query, object_id_type(0,0,0), cursor);
 	}
 	else
 	{
-		elog("condition order by [${order}] is not support.", ("order", condition.order_by));
-		std::vector<full_subject_vote_object> results;
-		return results;
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "condition order by [${order}] is not support.", ("order", condition.order_by));
+		return query_page<full_subject_vote_object>();
 	}
 }
 
@@ -3344,7 +3370,7 @@ std::vector<full_subject_vote_object> database_api_impl::get_subject_by_id(const
 		subject_statistics_object* vote_statistics = (subject_statistics_object*)_db.find_object(itr->statistics);
 		if (vote_statistics == NULL)//主题创建了，但是还没有投票
 		{
-			elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "subject statistics id ${id} is not found.", ("id", itr->statistics));
 		}
 		else
 		{
@@ -3355,7 +3381,7 @@ std::vector<full_subject_vote_object> database_api_impl::get_subject_by_id(const
 		//查看当前账户是否投过票
 		if ( account_name_or_id == "" || account_name_or_id == "null" )
 		{
-			elog("account name or id [${account}] is empty.", ("account",account_name_or_id) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "account name or id [${account}] is empty.", ("account",account_name_or_id) );
 		}
 		else
 		{
@@ -3371,16 +3397,7 @@ std::vector<full_subject_vote_object> database_api_impl::get_subject_by_id(const
 			}
 			if (account != nullptr)
 			{
-				const auto& idx_vote = _db.get_index_type<subject_vote_index>().indices().get<by_id>();
-				auto itr_vote = idx_vote.begin();
-
-				for(;itr_vote != idx_vote.end(); itr_vote++)
-				{
-					if(itr_vote->voter == account->id && itr_vote->subject_id == one.subject_id)
-					{
-						one.subject_vote_id.push_back(itr_vote->id);
-					}
-				}
+				one.subject_vote_id = get_subject_vote_ids(account->id, itr->id);
 			}
 		}
 		result.push_back(one);
@@ -3388,18 +3405,38 @@ std::vector<full_subject_vote_object> database_api_impl::get_subject_by_id(const
 	return result;
 }
 
+vector<object_id_type> database_api_impl::get_subject_vote_ids(account_id_type voter, subject_id_type subject_id)const
+{
+	vector<object_id_type> result;
+	const auto& idx_vote = _db.get_index_type<subject_vote_index>().indices().get<by_voter_subject>();
+	auto range = idx_vote.equal_range(boost::make_tuple(voter, subject_id));
+	for(auto itr_vote = range.first; itr_vote != range.second; itr_vote++)
+		result.push_back(itr_vote->id);
+	return result;
+}
+
 std::vector<full_subject_vote_object> database_api::get_subjects_by_creator( const query_condition &condition, const string &creator_name_or_id )const
 {
-	return my->get_subjects_by_creator( condition, creator_name_or_id );
+	return my->_db.with_read_access( [&]() { return my->get_subjects_by_creator( condition, creator_name_or_id ); } );
 }
 
 std::vector<full_subject_vote_object> database_api_impl::get_subjects_by_creator( const query_condition &condition, const string &creator_name_or_id )const
 {
-	std::vector<full_subject_vote_object> result;
+	return get_subjects_by_creator_page( condition, creator_name_or_id, optional<query_cursor>() ).items;
+}
+
+query_page<full_subject_vote_object> database_api::get_subjects_by_creator_page( const query_condition &condition, const string &creator_name_or_id, optional<query_cursor> cursor )const
+{
+	return my->_db.with_read_access( [&]() { return my->get_subjects_by_creator_page( condition, creator_name_or_id, cursor ); } );
+}
+
+query_page<full_subject_vote_object> database_api_impl::get_subjects_by_creator_page( const query_condition &condition, const string &creator_name_or_id, const optional<query_cursor>& cursor )const
+{
+	query_page<full_subject_vote_object> result;
 
 	if ( creator_name_or_id == "" || creator_name_or_id == "null" )
 	{
-		elog("creator name or id [${account}] is empty.", ("account",creator_name_or_id) );
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "creator name or id [${account}] is empty.", ("account",creator_name_or_id) );
 	}
 	else
 	{
@@ -3415,7 +3452,7 @@ std::vector<full_subject_vote_object> database_api_impl::get_subjects_by_creator
 		}
 		if (account != nullptr)
 		{
-			result =  get_subjects<by_creator_time>(condition, query_subjects_by_creator, account->id);
+			result =  get_subjects_page<by_creator_time>(condition, query_subjects_by_creator, account->id, cursor);
 		}
 	}
 
@@ -3424,64 +3461,84 @@ std::vector<full_subject_vote_object> database_api_impl::get_subjects_by_creator
 
 
 
-std::vector<token_brief> database_api_impl::get_tokens_brief_impl(const token_query_condition &condition, query_token_type type)const
+query_page<token_brief> database_api_impl::get_tokens_brief_impl(const token_query_condition &condition, query_token_type type, const optional<query_cursor> &cursor)const
 {
 	//打印传入参数
-	elog("start [${start}] , limit[${limit}]", ("start", condition.start)("limit", condition.limit));
-	elog("start time[${stime}] , end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
-	elog("order_by[${order_by}],status[${status}],my_account[${my_account}] ", ("status", condition.status)("order_by", condition.order_by)("my_account", condition.my_account));
+	tlog("start [${start}] , limit[${limit}]", ("start", condition.start)("limit", condition.limit));
+	tlog("start time[${stime}] , end time[${etime}]", ("stime", condition.start_time)("etime", condition.end_time));
+	tlog("order_by[${order_by}],status[${status}],my_account[${my_account}] ", ("status", condition.status)("order_by", condition.order_by)("my_account", condition.my_account));
 
 	//"create_time" | "end_time" |"buy_amount" | "buyer_number" | "guaranty_credit"
 	if (condition.order_by == "create_time")
 	{
-		return get_tokens_brief_template_by_global_negative<by_create_time>(condition, type, "by_create_time");
+		return get_tokens_brief_template_by_global_negative<by_create_time>(condition, type, cursor, "by_create_time");
 	}
 	else if (condition.order_by == "end_time")
 	{
-		return get_tokens_brief_template_by_global_positive<by_end_time>(condition, type, "by_end_time");
+		return get_tokens_brief_template_by_global_positive<by_end_time>(condition, type, cursor, "by_end_time");
 	}
 
 	//认购AFT最多
  	else if (condition.order_by == "actual_core_asset_total")
  	{
- 		return get_tokens_brief_template_by_statistics_negative<by_actual_core_asset_total>(condition, type);
+ 		return get_tokens_brief_template_by_statistics_negative<by_actual_core_asset_total>(condition, type, cursor);
  	}
 	//认购人数最多
 	else if (condition.order_by == "buyer_number")
 	{
-	 	return get_tokens_brief_template_by_statistics_negative<by_buyer_number>(condition, type);
+	 	return get_tokens_brief_template_by_statistics_negative<by_buyer_number>(condition, type, cursor);
 	}
 	//抵押信用最多
  	else if (condition.order_by == "guaranty_credit")
  	{
- 		return get_tokens_brief_template_by_global_negative<by_guaranty_credit>(condition, type);
+ 		return get_tokens_brief_template_by_global_negative<by_guaranty_credit>(condition, type, cursor);
  	}
 	else
 	{
-		return std::vector<token_brief>();
+		return query_page<token_brief>();
 	}
 
 }
 
 std::vector<token_brief> database_api::get_tokens_brief(const token_query_condition &condition)const
 {
-	return my->get_tokens_brief( condition );
+	return my->_db.with_read_access( [&]() { return my->get_tokens_brief( condition ); } );
 }
 
 std::vector<token_brief> database_api_impl::get_tokens_brief(const token_query_condition &condition)const
 {
-	return get_tokens_brief_impl(condition, market_tokens_query);
+	return get_tokens_brief_impl(condition, market_tokens_query, optional<query_cursor>()).items;
 }
 
 
 std::vector<token_brief> database_api::my_get_tokens_brief(const token_query_condition &condition)const
 {
-	return my->my_get_tokens_brief(condition);
+	return my->_db.with_read_access( [&]() { return my->my_get_tokens_brief(condition); } );
 }
 
 std::vector<token_brief> database_api_impl::my_get_tokens_brief(const token_query_condition &condition)const
 {
-	return get_tokens_brief_impl(condition, my_tokens_query);
+	return get_tokens_brief_impl(condition, my_tokens_query, optional<query_cursor>()).items;
+}
+
+query_page<token_brief> database_api::get_tokens_brief_page(const token_query_condition &condition, optional<query_cursor> cursor)const
+{
+	return my->_db.with_read_access( [&]() { return my->get_tokens_brief_page( condition, cursor ); } );
+}
+
+query_page<token_brief> database_api_impl::get_tokens_brief_page(const token_query_condition &condition, const optional<query_cursor>& cursor)const
+{
+	return get_tokens_brief_impl(condition, market_tokens_query, cursor);
+}
+
+query_page<token_brief> database_api::my_get_tokens_brief_page(const token_query_condition &condition, optional<query_cursor> cursor)const
+{
+	return my->_db.with_read_access( [&]() { return my->my_get_tokens_brief_page( condition, cursor ); } );
+}
+
+query_page<token_brief> database_api_impl::my_get_tokens_brief_page(const token_query_condition &condition, const optional<query_cursor>& cursor)const
+{
+	return get_tokens_brief_impl(condition, my_tokens_query, cursor);
 }
 
 optional<token_brief> database_api::get_token_brief_by_symbol_or_id(const string &token_symbol_or_id, const string &my_account)const
@@ -3505,12 +3562,12 @@ optional<token_brief> database_api_impl::my_get_token_brief_by_symbol_or_id(cons
 
 optional<token_brief> database_api_impl::get_token_brief_by_symbol_or_id_impl(const string &token_symbol_or_id, const string &my_account, query_token_type type)const
 {
-	elog("token_symbol_or_id[${token_symbol_or_id}], my_account[${my_account}]", ("token_symbol_or_id", token_symbol_or_id)("my_account", my_account));
+	tlog("token_symbol_or_id[${token_symbol_or_id}], my_account[${my_account}]", ("token_symbol_or_id", token_symbol_or_id)("my_account", my_account));
 
 	object_id_type token_id = object_id_type(0,0,0);
 	if ( token_symbol_or_id == "" || token_symbol_or_id == "null" )
 	{
-		elog("token name or id [${account}] is empty.", ("token",token_symbol_or_id) );
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "token name or id [${account}] is empty.", ("token",token_symbol_or_id) );
 		return {};
 	}
 	if (std::isdigit(token_symbol_or_id[0]))
@@ -3587,7 +3644,7 @@ optional<token_brief> database_api_impl::get_token_brief_by_symbol_or_id_impl(co
 		token_statistics_object* token_statistics = (token_statistics_object*)_db.find_object(itr->statistics);
 		if (token_statistics == NULL)//还没开始众筹
 		{
-			elog("token statistics id ${id} is not found.", ("id", itr->statistics));
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "token statistics id ${id} is not found.", ("id", itr->statistics));
 		}
 		else
 		{
@@ -3602,7 +3659,7 @@ optional<token_brief> database_api_impl::get_token_brief_by_symbol_or_id_impl(co
 		//查看当前账户是否参与过这个众筹项目
 		if ( my_account == "" || my_account == "null" )
 		{
-			elog("my account name or id [${account}] is empty.", ("account",my_account) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "my account name or id [${account}] is empty.", ("account",my_account) );
 		}
 		else
 		{
@@ -3618,19 +3675,16 @@ optional<token_brief> database_api_impl::get_token_brief_by_symbol_or_id_impl(co
 			}
 			if (account != nullptr)
 			{
-				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-				auto itr_buy = idx_buy.begin();
+				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+				auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(one.token_id)));
 
-				for(;itr_buy != idx_buy.end(); itr_buy++)
+				for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
 				{
-					if(itr_buy->buyer == account->id && itr_buy->token_id == one.token_id)
+					one.buy_count++;
+					if (type == my_tokens_query)
 					{
-						one.buy_count++;
-						if (type == my_tokens_query)
-						{
-							one.my_participate.push_back(itr_buy->template_parameter);
-						}						
-					}
+						one.my_participate.push_back(itr_buy->template_parameter);
+					}						
 				}
 			}
 		}
@@ -3654,7 +3708,7 @@ std::vector<token_brief> database_api_impl::my_get_my_create_tokens_brief(const
 	account_id_type my_id;
 	if ( condition.my_account == "" || condition.my_account == "null" )
 	{
-		elog("my account name or id [${my_account}] is empty.", ("my_account",condition.my_account) );
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "my account name or id [${my_account}] is empty.", ("my_account",condition.my_account) );
 	}
 	else
 	{
@@ -3726,7 +3780,7 @@ std::vector<token_brief> database_api_impl::my_get_my_create_tokens_brief(const
 				token_statistics_object* token_statistics = (token_statistics_object*)_db.find_object(itr->statistics);
 				if (token_statistics == NULL)//主题创建了，但是还没有投票
 				{
-					elog("subject statistics id ${id} is not found.", ("id", itr->statistics));
+					elog_limited(API_ERROR_LOGS_PER_SECOND, "subject statistics id ${id} is not found.", ("id", itr->statistics));
 				}
 				else
 				{
@@ -3761,12 +3815,12 @@ optional<token_detail> database_api::get_token_detail(const string &token_symbol
 
 optional<token_detail> database_api_impl::get_token_detail(const string &token_symbol_or_id, const string &my_account)const
 {
-	elog("token_symbol_or_id[${token_symbol_or_id}], my_account[${my_account}]", ("token_symbol_or_id", token_symbol_or_id)("my_account", my_account));
+	tlog("token_symbol_or_id[${token_symbol_or_id}], my_account[${my_account}]", ("token_symbol_or_id", token_symbol_or_id)("my_account", my_account));
 
 	object_id_type token_id(0,0,0);
 	if ( token_symbol_or_id == "" || token_symbol_or_id == "null" )
 	{
-		elog("token name or id [${account}] is empty.", ("token",token_symbol_or_id) );
+		elog_limited(API_ERROR_LOGS_PER_SECOND, "token name or id [${account}] is empty.", ("token",token_symbol_or_id) );
 		return {};
 	}
 	if (std::isdigit(token_symbol_or_id[0]))
@@ -3850,7 +3904,7 @@ optional<token_detail> database_api_impl::get_token_detail(const string &token_s
 		token_statistics_object* token_statistics = (token_statistics_object*)_db.find_object(itr->statistics);
 		if (token_statistics == NULL)//还没开始众筹
 		{
-			elog("token statistics id ${id} is not found.", ("id", itr->statistics));
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "token statistics id ${id} is not found.", ("id", itr->statistics));
 		}
 		else
 		{
@@ -3869,7 +3923,7 @@ optional<token_detail> database_api_impl::get_token_detail(const string &token_s
 		//查看当前账户是否参与过这个众筹项目
 		if ( my_account == "" || my_account == "null" )
 		{
-			elog("my account name or id [${account}] is empty.", ("account",my_account) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "my account name or id [${account}] is empty.", ("account",my_account) );
 		}
 		else
 		{
@@ -3885,16 +3939,13 @@ optional<token_detail> database_api_impl::get_token_detail(const string &token_s
 			}
 			if (account != nullptr)
 			{
-				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-				auto itr_buy = idx_buy.begin();
+				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+				auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(one.token_id)));
 
-				for(;itr_buy != idx_buy.end(); itr_buy++)
+				for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
 				{
-					if(itr_buy->buyer == account->id && itr_buy->token_id == one.token_id)
-					{
-						one.buy_count++;
-						one.my_participate.push_back(itr_buy->template_parameter);
-					}
+					one.buy_count++;
+					one.my_participate.push_back(itr_buy->template_parameter);
 				}
 			}
 		}
@@ -3911,7 +3962,7 @@ vector<token_buy_object> database_api::get_buy_token_detail(object_id_type token
 
 vector<token_buy_object> database_api_impl::get_buy_token_detail(object_id_type token_id, const string &my_account)const
 {
-	elog("token_id[${token_id}], my_account[${my_account}]", ("token_id", token_id)("my_account", my_account));
+	tlog("token_id[${token_id}], my_account[${my_account}]", ("token_id", token_id)("my_account", my_account));
 	vector<token_buy_object> result;
 	const auto& idx = _db.get_index_type<token_index>().indices().get<by_id>();
 	auto itr = idx.find(token_id);
@@ -3920,7 +3971,7 @@ vector<token_buy_object> database_api_impl::get_buy_token_detail(object_id_type
 		//查看当前账户是否参与过这个众筹项目
 		if ( my_account == "" || my_account == "null" )
 		{
-			elog("my account name or id [${account}] is empty.", ("account",my_account) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "my account name or id [${account}] is empty.", ("account",my_account) );
 		}
 		else
 		{
@@ -3936,15 +3987,12 @@ vector<token_buy_object> database_api_impl::get_buy_token_detail(object_id_type
 			}
 			if (account != nullptr)
 			{
-				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_id>();
-				auto itr_buy = idx_buy.begin();
+				const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_buyer_token>();
+				auto range_buy = idx_buy.equal_range(boost::make_tuple(account->id, token_id_type(token_id)));
 
-				for(;itr_buy != idx_buy.end(); itr_buy++)
+				for(auto itr_buy = range_buy.first; itr_buy != range_buy.second; itr_buy++)
 				{
-					if(itr_buy->buyer == account->id && itr_buy->token_id == token_id)
-					{
-						result.push_back(*itr_buy);
-					}
+					result.push_back(*itr_buy);
 				}
 			}
 		}
@@ -3958,7 +4006,7 @@ uint32_t database_api::get_buy_record_total(object_id_type token_id, const strin
 }
 uint32_t database_api_impl::get_buy_record_total(object_id_type token_id, const string &issue_account)const
 {
-	elog("token_id[${token_id}], issue_account[${issue_account}]", ("token_id", token_id)("issue_account", issue_account));
+	tlog("token_id[${token_id}], issue_account[${issue_account}]", ("token_id", token_id)("issue_account", issue_account));
 	
 	const auto& idx = _db.get_index_type<token_index>().indices().get<by_id>();
 	auto itr = idx.find(token_id);
@@ -3966,7 +4014,7 @@ uint32_t database_api_impl::get_buy_record_total(object_id_type token_id, const
 	{
 		if ( issue_account == "" || issue_account == "null" )
 		{
-			elog("publish account name or id [${account}] is empty.", ("account",issue_account) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "publish account name or id [${account}] is empty.", ("account",issue_account) );
 		}
 		else
 		{
@@ -4013,21 +4061,37 @@ vector<token_buy_object> database_api::get_buy_list(uint32_t start, uint32_t lim
 
 vector<token_buy_object> database_api_impl::get_buy_list(uint32_t start, uint32_t limit, object_id_type token_id, const string &issue_account)const
 {
-	elog("start[${start}],limit[${limit}],token_id[${token_id}], issue_account[${issue_account}]", ("start", start)("limit", limit)("token_id", token_id)("issue_account", issue_account));
+	return get_buy_list_impl(start, limit, token_id, issue_account, false, optional<query_cursor>()).items;
+}
+
+query_page<token_buy_object> database_api::get_buy_list_page(object_id_type token_id, const string &issue_account, optional<query_cursor> cursor, uint32_t limit)const
+{
+	return my->_db.with_read_access( [&]() { return my->get_buy_list_page( token_id, issue_account, cursor, limit ); } );
+}
+
+query_page<token_buy_object> database_api_impl::get_buy_list_page(object_id_type token_id, const string &issue_account, const optional<query_cursor>& cursor, uint32_t limit)const
+{
+	return get_buy_list_impl(0, limit, token_id, issue_account, true, cursor);
+}
+
+query_page<token_buy_object> database_api_impl::get_buy_list_impl(uint32_t start, uint32_t limit, object_id_type token_id, const string &issue_account, bool paged, const optional<query_cursor> &cursor)const
+{
+	tlog("start[${start}],limit[${limit}],token_id[${token_id}], issue_account[${issue_account}]", ("start", start)("limit", limit)("token_id", token_id)("issue_account", issue_account));
 
 	uint32_t num = limit <= MAX_BUY_TOKEN_RECORD_NUM_FOR_QUERY_RESULTS ? limit : MAX_BUY_TOKEN_RECORD_NUM_FOR_QUERY_RESULTS;
-	vector<token_buy_object> result;
+	query_page<token_buy_object> page;
+	vector<token_buy_object> &result = page.items;
 
 	const auto& idx = _db.get_index_type<token_index>().indices().get<by_id>();
 	auto itr = idx.find(token_id);
 	if (itr != idx.end())
 	{
         if ( !(itr->result.is_succeed) )//通证众筹失败
-            return result;
+            return page;
 
 		if ( issue_account == "" || issue_account == "null" )
 		{
-			elog("publish account name or id [${account}] is empty.", ("account",issue_account) );
+			elog_limited(API_ERROR_LOGS_PER_SECOND, "publish account name or id [${account}] is empty.", ("account",issue_account) );
 		}
 		else
 		{
@@ -4047,35 +4111,47 @@ vector<token_buy_object> database_api_impl::get_buy_list(uint32_t start, uint32_
 				if(itr->issuer == account->id)
 				{
 					//查看查询次数是否超了限制值
+					// shared by every connection and read by the read workers, hence the lock
 					static map<object_id_type, uint32_t> get_records_num_sum;
+					static std::mutex get_records_num_lock;
+					std::unique_lock<std::mutex> records_guard( get_records_num_lock );
 					map<object_id_type, uint32_t>::iterator it_find = get_records_num_sum.find(token_id);
 					if( it_find==get_records_num_sum.end() )
 					{
 						get_records_num_sum.insert(make_pair(token_id,0));
-						elog("This is the first time get_buy_list[${token_id}]", ("token_id", token_id));
+						tlog("This is the first time get_buy_list[${token_id}]", ("token_id", token_id));
 					}
 					else
 					{
-						elog("You have get_buy_list for record num [${num}],max num[${max_num}]", ("num", get_records_num_sum[token_id])("max_num", MAX_GET_BUY_LIST_RECORD_NUM));
+						tlog("You have get_buy_list for record num [${num}],max num[${max_num}]", ("num", get_records_num_sum[token_id])("max_num", MAX_GET_BUY_LIST_RECORD_NUM));
 						if ( get_records_num_sum[token_id] >= MAX_GET_BUY_LIST_RECORD_NUM )
 						{
 							FC_ASSERT(get_records_num_sum[token_id] >= MAX_GET_BUY_LIST_RECORD_NUM, "You have get_buy_list for record num [${num}],max num[${max_num}]", ("num", get_records_num_sum[token_id])("max_num", MAX_GET_BUY_LIST_RECORD_NUM) );
 							return {};
 						}
 					}
-					
+					records_guard.unlock();
 
 
 					//开始统计
 					const auto& idx_buy = _db.get_index_type<token_buy_index>().indices().get<by_token_id>();
-                    auto itr_buy_begin = idx_buy.lower_bound(token_id);
-                    auto itr_buy_end = idx_buy.upper_bound(token_id);
-                    std::advance(itr_buy_begin,start);
-					uint32_t count = 0;
-                    for(auto itr_buy = itr_buy_begin;itr_buy != itr_buy_end && count<num; itr_buy++, count++)
+					if (paged)
+					{
+						page = get_page_by_key(idx_buy, token_id_type(token_id), cursor, num);
+					}
+					else
 					{
-						result.push_back(*itr_buy);
+						auto itr_buy_begin = idx_buy.lower_bound(token_id);
+						auto itr_buy_end = idx_buy.upper_bound(token_id);
+						for(uint32_t skipped = 0; skipped < start && itr_buy_begin != itr_buy_end; skipped++)
+							itr_buy_begin++;
+						uint32_t count = 0;
+						for(auto itr_buy = itr_buy_begin;itr_buy != itr_buy_end && count<num; itr_buy++, count++)
+						{
+							result.push_back(*itr_buy);
+						}
 					}
+					records_guard.lock();
 					get_records_num_sum[token_id] += result.size();
 				}
 				else
@@ -4086,7 +4162,7 @@ vector<token_buy_object> database_api_impl::get_buy_list(uint32_t start, uint32_
 			}
 		}
 	}
-	return result;
+	return page;
 }
 
 //[end]
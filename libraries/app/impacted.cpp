@@ -104,6 +104,7 @@ struct get_impacted_account_visitor
    void operator()( const asset_global_settle_operation& op ) {}
    void operator()( const asset_publish_feed_operation& op ) {}
    void operator()( const coin_feed_price_operation& op) {}
+   void operator()( const coin_feed_price_batch_operation& op ) {}
    void operator()( const module_cfg_operation& op) {}
    void operator()( const witness_create_operation& op )
    {
@@ -82,6 +82,13 @@ namespace graphene { namespace app {
       asset_id_type   asset_id;
       int             count;
    };
+
+   struct performance_report
+   {
+      /// operation types applied at least once, by total evaluator time, longest first
+      vector< pair<string, operation_stats> > operations;
+      block_apply_stats                       blocks;
+   };
    
    /**
     * @brief The history_api class implements the RPC API for account history
@@ -319,6 +326,24 @@ namespace graphene { namespace app {
          graphene::chain::database& _db;
    };
 
+   /**
+    * @brief The performance_api class exposes the evaluator and block apply timings kept by the database
+    */
+   class performance_api
+   {
+      public:
+         performance_api(graphene::chain::database& db);
+
+         performance_report get_performance_stats()const;
+         /// @brief Clear all counters, e.g. before a load test
+         void reset_performance_stats();
+         /// @brief Turn collection on or off, it is on by default
+         void set_performance_stats_enabled( bool enabled );
+
+      private:
+         graphene::chain::database& _db;
+   };
+
    /**
     * @brief The login_api class implements the bottom layer of the RPC API
     *
@@ -354,6 +379,8 @@ namespace graphene { namespace app {
          fc::api<crypto_api> crypto()const;
          /// @brief Retrieve the asset API
          fc::api<asset_api> asset()const;
+         /// @brief Retrieve the performance API
+         fc::api<performance_api> performance()const;
          /// @brief Retrieve the debug API (if available)
          fc::api<graphene::debug_witness::debug_api> debug()const;
 
@@ -369,6 +396,7 @@ namespace graphene { namespace app {
          optional< fc::api<history_api> >  _history_api;
          optional< fc::api<crypto_api> > _crypto_api;
          optional< fc::api<asset_api> > _asset_api;
+         optional< fc::api<performance_api> > _performance_api;
          optional< fc::api<graphene::debug_witness::debug_api> > _debug_api;
    };
 
@@ -385,6 +413,7 @@ FC_REFLECT( graphene::app::verify_range_proof_rewind_result,
 
 FC_REFLECT( graphene::app::account_asset_balance, (name)(account_id)(amount) );
 FC_REFLECT( graphene::app::asset_holders, (asset_id)(count) );
+FC_REFLECT( graphene::app::performance_report, (operations)(blocks) );
 
 FC_API(graphene::app::history_api,
        (get_account_history)
@@ -427,6 +456,11 @@ FC_API(graphene::app::asset_api,
 	   (get_asset_holders_count)
        (get_all_asset_holders)
      )
+FC_API(graphene::app::performance_api,
+       (get_performance_stats)
+       (reset_performance_stats)
+       (set_performance_stats_enabled)
+     )
 FC_API(graphene::app::login_api,
        (login)
        (block)
@@ -436,5 +470,6 @@ FC_API(graphene::app::login_api,
        (network_node)
        (crypto)
        (asset)
+       (performance)
        (debug)
      )
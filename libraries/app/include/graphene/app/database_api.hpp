@@ -109,6 +109,25 @@ struct market_trade
    double                     value;
 };
 
+/**
+ * @brief Position of a keyset paged query
+ *
+ * Holds the sort key and id of the last object returned by a page. Clients treat it as opaque and pass it back
+ * unchanged to fetch the following page, which then resumes with a single lower_bound on the (key, id) index.
+ */
+struct query_cursor
+{
+   fc::variant                key;
+   object_id_type             id;
+};
+
+template<typename T>
+struct query_page
+{
+   vector<T>                  items;
+   optional<query_cursor>     next; ///< cursor of the following page, empty once the query is exhausted
+};
+
 /**
  * @brief The database_api class implements the RPC API for the chain database.
  *
@@ -148,6 +167,20 @@ class database_api
        * This unsubscribes from all subscribed markets and objects.
        */
       void cancel_all_subscriptions();
+      /**
+       * @brief Receive every change to objects of one space and type, e.g. 1.7 for all limit orders
+       *
+       * Requires set_subscribe_callback() first; updates arrive through that callback.
+       */
+      void subscribe_to_object_type( uint8_t space, uint8_t type );
+      void unsubscribe_from_object_type( uint8_t space, uint8_t type );
+      /**
+       * @brief Receive every change to objects relevant to the given accounts
+       *
+       * Same as get_full_accounts() with subscribe set, without fetching the accounts.
+       */
+      void subscribe_to_accounts( const vector<account_id_type>& accounts );
+      void unsubscribe_from_accounts( const vector<account_id_type>& accounts );
 
       /////////////////////////////
       // Blocks and transactions //
@@ -641,6 +674,22 @@ class database_api
       std::vector<subject_event_object> get_subject_events_by_subject_id( uint32_t start, uint32_t limit, subject_id_type subject_id )const;
       std::vector<subject_event_object> get_subject_events_by_operator( uint32_t start, uint32_t limit, account_id_type operator_id )const;
 
+      /**
+       * @brief Keyset paged variants of the subject queries
+       * @param cursor: null for the first page, otherwise the @ref query_page::next of the previous page
+       * @param limit: the maximum number of objects to return
+       *
+       * Unlike the start/limit queries, the cost of a page does not depend on how deep into the result set it is.
+       * The start field of @ref query_condition is ignored by these calls.
+       */
+      query_page<subject_object> get_subjects_by_status_page( subject_object::subject_status status, optional<query_cursor> cursor, uint32_t limit )const;
+      query_page<subject_vote_object> get_subject_votes_by_voter_page( string account_name_or_id, optional<query_cursor> cursor, uint32_t limit )const;
+      query_page<subject_vote_object> get_subject_votes_by_subject_id_page( subject_id_type subject_id, optional<query_cursor> cursor, uint32_t limit )const;
+      query_page<full_subject_vote_object> get_my_create_subjects_page( const query_condition &condition, optional<query_cursor> cursor )const;
+      query_page<full_subject_vote_object> market_get_subjects_page( const query_condition &condition, optional<query_cursor> cursor )const;
+      query_page<full_subject_vote_object> my_get_subjects_page( const query_condition &condition, optional<query_cursor> cursor )const;
+      query_page<full_subject_vote_object> get_subjects_by_creator_page( const query_condition &condition, const string &creator_name_or_id, optional<query_cursor> cursor )const;
+
 	  //[lilianwen add 2017-10-24]
 	  std::vector<full_subject_vote_object> get_my_create_subjects(const query_condition &condition)const;
 	  std::vector<full_subject_vote_object> market_get_subjects(const query_condition &condition)const;
@@ -675,6 +724,16 @@ class database_api
 	  vector<token_buy_object> get_buy_list(uint32_t start, uint32_t limit, object_id_type token_id, const string &publish_account)const;
 	  //[end]
 
+      /**
+       * @brief Keyset paged variants of the token queries
+       * @param cursor: null for the first page, otherwise the @ref query_page::next of the previous page
+       *
+       * The start field of @ref token_query_condition is ignored by these calls.
+       */
+      query_page<token_brief> get_tokens_brief_page( const token_query_condition &condition, optional<query_cursor> cursor )const;
+      query_page<token_brief> my_get_tokens_brief_page( const token_query_condition &condition, optional<query_cursor> cursor )const;
+      query_page<token_buy_object> get_buy_list_page( object_id_type token_id, const string &publish_account, optional<query_cursor> cursor, uint32_t limit )const;
+
       std::vector<token_object> get_tokens_by_collected_core_asset( uint32_t start, uint32_t limit )const;
       optional<token_object> get_token_by_id( token_id_type project_id )const;
    private:
@@ -688,6 +747,8 @@ FC_REFLECT( graphene::app::order_book, (base)(quote)(bids)(asks) );
 FC_REFLECT( graphene::app::market_ticker, (base)(quote)(latest)(lowest_ask)(highest_bid)(percent_change)(base_volume)(quote_volume) );
 FC_REFLECT( graphene::app::market_volume, (base)(quote)(base_volume)(quote_volume) );
 FC_REFLECT( graphene::app::market_trade, (date)(price)(amount)(value) );
+FC_REFLECT( graphene::app::query_cursor, (key)(id) );
+FC_REFLECT_TEMPLATE( (typename T), graphene::app::query_page<T>, (items)(next) );
 
 FC_API(graphene::app::database_api,
    // Objects
@@ -698,6 +759,10 @@ FC_API(graphene::app::database_api,
    (set_pending_transaction_callback)
    (set_block_applied_callback)
    (cancel_all_subscriptions)
+   (subscribe_to_object_type)
+   (unsubscribe_from_object_type)
+   (subscribe_to_accounts)
+   (unsubscribe_from_accounts)
 
    // Blocks and transactions
    (get_block_header)
@@ -794,6 +859,13 @@ FC_API(graphene::app::database_api,
    (get_subject_votes_by_subject_id)
    (get_subject_events_by_subject_id)
    (get_subject_events_by_operator)
+   (get_subjects_by_status_page)
+   (get_subject_votes_by_voter_page)
+   (get_subject_votes_by_subject_id_page)
+   (get_my_create_subjects_page)
+   (market_get_subjects_page)
+   (my_get_subjects_page)
+   (get_subjects_by_creator_page)
 
    //[lilianwen add]
    (get_my_create_subjects)
@@ -808,6 +880,9 @@ FC_API(graphene::app::database_api,
    (get_buy_token_detail)
    (get_buy_record_total)
    (get_buy_list)
+   (get_tokens_brief_page)
+   (my_get_tokens_brief_page)
+   (get_buy_list_page)
    //[end]
 
    // Coins
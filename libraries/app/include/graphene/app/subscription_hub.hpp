@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2017 AssetFun, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+#include <graphene/chain/database.hpp>
+
+#include <fc/variant.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace graphene { namespace app {
+   using namespace graphene::chain;
+
+   /**
+    *  Object change subscriptions of every database_api connection on one database.
+    *
+    *  Subscriptions to single objects, to all objects of a space and type, and to the objects relevant
+    *  to an account are kept in reverse indexes, so a change only visits the subscribers interested
+    *  in it.  The changes of a block are coalesced into one update per subscriber, and each object
+    *  is converted to a variant at most once however many subscribers receive it.
+    *
+    *  Subscriptions may be added from the read worker threads of database::with_read_access().
+    */
+   class subscription_hub
+   {
+      public:
+         typedef uint64_t                                 subscriber_id;
+         typedef std::function<void(const fc::variant&)>  callback_type;
+
+         /// Most single objects one subscriber can follow, see subscribe_to_object()
+         static const size_t max_object_subscriptions = 1000;
+
+         /// The hub of db, created on first use and shared by everyone holding it
+         static std::shared_ptr<subscription_hub> get( database& db );
+
+         explicit subscription_hub( database& db );
+
+         /**
+          *  @param cb receives one array of updates per block, full objects for created and modified
+          *  objects and ids for removed ones
+          *  @param notify_remove_create also receive every created and removed object
+          */
+         subscriber_id add_subscriber( callback_type cb, bool notify_remove_create );
+         void          remove_subscriber( subscriber_id sub );
+
+         /// @return false if sub already follows max_object_subscriptions objects, in which case id is not added
+         bool   subscribe_to_object( subscriber_id sub, object_id_type id );
+         bool   is_subscribed_to_object( subscriber_id sub, object_id_type id )const;
+         void   subscribe_to_account( subscriber_id sub, account_id_type account );
+         void   unsubscribe_from_account( subscriber_id sub, account_id_type account );
+         size_t subscribed_account_count( subscriber_id sub )const;
+         void   subscribe_to_object_type( subscriber_id sub, uint8_t space, uint8_t type );
+         void   unsubscribe_from_object_type( subscriber_id sub, uint8_t space, uint8_t type );
+
+         size_t subscriber_count()const;
+
+      private:
+         struct subscriber
+         {
+            callback_type              callback;
+            bool                       notify_remove_create = false;
+            flat_set<object_id_type>   objects;
+            flat_set<account_id_type>  accounts;
+            flat_set<uint16_t>         types;
+         };
+
+         static uint16_t type_key( uint8_t space, uint8_t type ) { return (uint16_t(space) << 8) | type; }
+
+         void on_object_changes( const vector<object_change>& changes );
+
+         database&                                                      _db;
+         mutable std::mutex                                             _lock;
+         subscriber_id                                                  _next_subscriber = 1;
+         std::map< subscriber_id, subscriber >                          _subscribers;
+         std::unordered_map< object_id_type, flat_set<subscriber_id> >  _by_object;
+         std::map< account_id_type, flat_set<subscriber_id> >           _by_account;
+         std::map< uint16_t, flat_set<subscriber_id> >                  _by_type;
+         flat_set<subscriber_id>                                        _remove_create_subscribers;
+         boost::signals2::scoped_connection                             _changes_connection;
+   };
+
+} } // graphene::app
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2017 AssetFun, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/app/subscription_hub.hpp>
+
+#include <fc/thread/thread.hpp>
+
+#include <mutex>
+
+namespace graphene { namespace app {
+
+std::shared_ptr<subscription_hub> subscription_hub::get( database& db )
+{
+   static std::mutex lock;
+   static std::map< database*, std::weak_ptr<subscription_hub> > hubs;
+
+   std::lock_guard<std::mutex> guard( lock );
+   auto& weak = hubs[&db];
+   auto hub = weak.lock();
+   if( !hub )
+   {
+      hub = std::make_shared<subscription_hub>( db );
+      weak = hub;
+   }
+   return hub;
+}
+
+subscription_hub::subscription_hub( database& db ) : _db( db )
+{
+   _changes_connection = _db.object_changes.connect( [this]( const vector<object_change>& changes ) {
+      on_object_changes( changes );
+   });
+}
+
+subscription_hub::subscriber_id subscription_hub::add_subscriber( callback_type cb, bool notify_remove_create )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   subscriber_id sub = _next_subscriber++;
+   subscriber& s = _subscribers[sub];
+   s.callback = std::move( cb );
+   s.notify_remove_create = notify_remove_create;
+   if( notify_remove_create )
+      _remove_create_subscribers.insert( sub );
+   return sub;
+}
+
+size_t subscription_hub::subscriber_count()const
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   return _subscribers.size();
+}
+
+void subscription_hub::remove_subscriber( subscriber_id sub )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() )
+      return;
+
+   for( const auto& id : itr->second.objects )
+   {
+      auto o = _by_object.find( id );
+      o->second.erase( sub );
+      if( o->second.empty() )
+         _by_object.erase( o );
+   }
+   for( const auto& account : itr->second.accounts )
+   {
+      auto a = _by_account.find( account );
+      a->second.erase( sub );
+      if( a->second.empty() )
+         _by_account.erase( a );
+   }
+   for( auto key : itr->second.types )
+   {
+      auto t = _by_type.find( key );
+      t->second.erase( sub );
+      if( t->second.empty() )
+         _by_type.erase( t );
+   }
+   _remove_create_subscribers.erase( sub );
+   _subscribers.erase( itr );
+}
+
+bool subscription_hub::subscribe_to_object( subscriber_id sub, object_id_type id )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() )
+      return false;
+   auto& objects = itr->second.objects;
+   if( objects.count( id ) )
+      return true;
+   if( objects.size() >= max_object_subscriptions )
+      return false;
+   objects.insert( id );
+   _by_object[id].insert( sub );
+   return true;
+}
+
+bool subscription_hub::is_subscribed_to_object( subscriber_id sub, object_id_type id )const
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   return itr != _subscribers.end() && itr->second.objects.count( id ) > 0;
+}
+
+void subscription_hub::subscribe_to_account( subscriber_id sub, account_id_type account )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() )
+      return;
+   if( itr->second.accounts.insert( account ).second )
+      _by_account[account].insert( sub );
+}
+
+void subscription_hub::unsubscribe_from_account( subscriber_id sub, account_id_type account )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() || itr->second.accounts.erase( account ) == 0 )
+      return;
+   auto a = _by_account.find( account );
+   a->second.erase( sub );
+   if( a->second.empty() )
+      _by_account.erase( a );
+}
+
+size_t subscription_hub::subscribed_account_count( subscriber_id sub )const
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   return itr == _subscribers.end() ? 0 : itr->second.accounts.size();
+}
+
+void subscription_hub::subscribe_to_object_type( subscriber_id sub, uint8_t space, uint8_t type )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() )
+      return;
+   uint16_t key = type_key( space, type );
+   if( itr->second.types.insert( key ).second )
+      _by_type[key].insert( sub );
+}
+
+void subscription_hub::unsubscribe_from_object_type( subscriber_id sub, uint8_t space, uint8_t type )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   uint16_t key = type_key( space, type );
+   auto itr = _subscribers.find( sub );
+   if( itr == _subscribers.end() || itr->second.types.erase( key ) == 0 )
+      return;
+   auto t = _by_type.find( key );
+   t->second.erase( sub );
+   if( t->second.empty() )
+      _by_type.erase( t );
+}
+
+/** note: this method cannot yield because it is called in the middle of
+ * apply a block.
+ */
+void subscription_hub::on_object_changes( const vector<object_change>& changes )
+{
+   std::lock_guard<std::mutex> guard( _lock );
+   if( _subscribers.empty() )
+      return;
+
+   std::map< subscriber_id, vector<fc::variant> > updates;
+   vector<subscriber_id> hits;
+   for( const auto& change : changes )
+   {
+      hits.clear();
+      auto add_hits = [&hits]( const flat_set<subscriber_id>& subs ) {
+         hits.insert( hits.end(), subs.begin(), subs.end() );
+      };
+
+      if( change.kind != object_change::modified )
+         add_hits( _remove_create_subscribers );
+      auto by_object = _by_object.find( change.id );
+      if( by_object != _by_object.end() )
+         add_hits( by_object->second );
+      auto by_type = _by_type.find( type_key( change.id.space(), change.id.type() ) );
+      if( by_type != _by_type.end() )
+         add_hits( by_type->second );
+      for( const auto& account : change.accounts )
+      {
+         auto by_account = _by_account.find( account );
+         if( by_account != _by_account.end() )
+            add_hits( by_account->second );
+      }
+
+      if( !hits.empty() )
+      {
+         std::sort( hits.begin(), hits.end() );
+         hits.erase( std::unique( hits.begin(), hits.end() ), hits.end() );
+
+         fc::variant update;
+         if( change.kind == object_change::removed )
+            update = fc::variant( change.id );
+         else if( change.obj != nullptr )
+            update = change.obj->to_variant();
+
+         if( !update.is_null() )
+            for( auto sub : hits )
+               updates[sub].push_back( update );
+      }
+
+      // a removed object never changes again
+      if( change.kind == object_change::removed && by_object != _by_object.end() )
+      {
+         for( auto sub : by_object->second )
+            _subscribers[sub].objects.erase( change.id );
+         _by_object.erase( by_object );
+      }
+   }
+
+   if( updates.empty() )
+      return;
+
+   auto deliveries = std::make_shared< vector< std::pair<callback_type, fc::variant> > >();
+   deliveries->reserve( updates.size() );
+   for( auto& item : updates )
+      deliveries->emplace_back( _subscribers[item.first].callback, fc::variant( item.second ) );
+
+   fc::async( [deliveries](){
+      for( const auto& delivery : *deliveries )
+      {
+         try {
+            delivery.first( delivery.second );
+         } FC_CAPTURE_AND_LOG( (0) )
+      }
+   });
+}
+
+} } // graphene::app
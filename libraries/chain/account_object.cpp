@@ -267,4 +267,63 @@ void account_referrer_index::object_modified( const object& after  )
 {
 }
 
+void asset_holder_index::add( const account_balance_object& b )
+{
+   if( b.balance == 0 )
+      return;
+   if( _holders.insert( holder{ b.asset_type, b.balance, b.owner } ).second )
+      ++_counts[b.asset_type];
+}
+
+void asset_holder_index::remove( const account_balance_object& b )
+{
+   if( b.balance == 0 )
+      return;
+   auto h = _holders.find( boost::make_tuple( b.asset_type, b.balance, b.owner ) );
+   if( h == _holders.end() )
+      return;
+   _holders.erase( h );
+   auto itr = _counts.find( b.asset_type );
+   if( --itr->second == 0 )
+      _counts.erase( itr );
+}
+
+void asset_holder_index::object_inserted( const object& obj )
+{
+   add( static_cast<const account_balance_object&>( obj ) );
+}
+void asset_holder_index::object_removed( const object& obj )
+{
+   remove( static_cast<const account_balance_object&>( obj ) );
+}
+void asset_holder_index::about_to_modify( const object& before )
+{
+   remove( static_cast<const account_balance_object&>( before ) );
+}
+void asset_holder_index::object_modified( const object& after  )
+{
+   add( static_cast<const account_balance_object&>( after ) );
+}
+
+uint32_t asset_holder_index::holder_count( asset_id_type asset )const
+{
+   auto itr = _counts.find( asset );
+   return itr == _counts.end() ? 0 : itr->second;
+}
+
+vector<asset_holder_index::holder> asset_holder_index::get_holders( asset_id_type asset, uint32_t start, uint32_t limit )const
+{
+   vector<holder> result;
+   uint32_t count = holder_count( asset );
+   if( start >= count )
+      return result;
+
+   auto first = _holders.lower_bound( boost::make_tuple( asset ) );
+   auto itr = _holders.nth( _holders.rank( first ) + start );
+   result.reserve( std::min( limit, count - start ) );
+   for( ; itr != _holders.end() && itr->asset_type == asset && result.size() < limit; ++itr )
+      result.push_back( *itr );
+   return result;
+}
+
 } } // graphene::chain
@@ -25,6 +25,9 @@
 #include <graphene/chain/protocol/fee_schedule.hpp>
 #include <fc/io/raw.hpp>
 #include <fc/smart_ref_impl.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <cstring>
 
 namespace graphene { namespace chain {
 
@@ -39,7 +42,28 @@ FC_REFLECT( graphene::chain::index_entry, (block_pos)(block_size)(block_id) );
 
 namespace graphene { namespace chain {
 
-void block_database::open( const fc::path& dbdir )
+namespace {
+
+   /// Bytes written past the mapped part of a file before store() maps it again; reads of that tail use the streams
+   const uint64_t unmapped_tail_limit = 64 * 1024 * 1024;
+
+   /// Maps all of file read-only, returns the mapped size (0 for an empty file, which cannot be mapped)
+   uint64_t map_file( const fc::path& file, std::unique_ptr<fc::file_mapping>& mapping,
+                      std::unique_ptr<fc::mapped_region>& region )
+   {
+      region.reset();
+      mapping.reset();
+      uint64_t file_size = fc::file_size( file );
+      if( file_size == 0 )
+         return 0;
+      mapping.reset( new fc::file_mapping( file.generic_string().c_str(), fc::read_only ) );
+      region.reset( new fc::mapped_region( *mapping, fc::read_only, 0, file_size ) );
+      return file_size;
+   }
+
+}
+
+void block_database::open( const fc::path& dbdir, bool use_mmap )
 { try {
    fc::create_directories(dbdir);
    _block_num_to_pos.exceptions(std::ios_base::failbit | std::ios_base::badbit);
@@ -55,8 +79,23 @@ void block_database::open( const fc::path& dbdir )
      _block_num_to_pos.open( (dbdir/"index").generic_string().c_str(), std::fstream::binary | std::fstream::in | std::fstream::out );
      _blocks.open( (dbdir/"blocks").generic_string().c_str(), std::fstream::binary | std::fstream::in | std::fstream::out );
    }
+
+   _owner       = &fc::thread::current();
+   _use_mmap    = use_mmap;
+   _blocks_path = dbdir/"blocks";
+   _index_path  = dbdir/"index";
+   _index_bytes = fc::file_size( _index_path );
+   if( _use_mmap )
+      map_files();
 } FC_CAPTURE_AND_RETHROW( (dbdir) ) }
 
+void block_database::map_files()
+{
+   flush();
+   _blocks_mapped = map_file( _blocks_path, _blocks_mapping, _blocks_region );
+   _index_mapped  = map_file( _index_path, _index_mapping, _index_region );
+}
+
 bool block_database::is_open()const
 {
   return _blocks.is_open();
@@ -64,6 +103,13 @@ bool block_database::is_open()const
 
 void block_database::close()
 {
+  assert( _owner == &fc::thread::current() );
+  _blocks_region.reset();
+  _blocks_mapping.reset();
+  _index_region.reset();
+  _index_mapping.reset();
+  _blocks_mapped = 0;
+  _index_mapped  = 0;
   _blocks.close();
   _block_num_to_pos.close();
 }
@@ -76,6 +122,7 @@ void block_database::flush()
 
 void block_database::store( const block_id_type& _id, const signed_block& b )
 {
+   assert( _owner == &fc::thread::current() );
    block_id_type id = _id;
    if( id == block_id_type() )
    {
@@ -83,34 +130,85 @@ void block_database::store( const block_id_type& _id, const signed_block& b )
       elog( "id argument of block_database::store() was not initialized for block ${id}", ("id", id) );
    }
    auto num = block_header::num_from_id(id);
-   _block_num_to_pos.seekp( sizeof( index_entry ) * num );
+   write_index_entry( sizeof( index_entry ) * num, [&]( index_entry& e ) {
+      _blocks.seekp( 0, _blocks.end );
+      auto vec = fc::raw::pack( b );
+      e.block_pos  = _blocks.tellp();
+      e.block_size = vec.size();
+      e.block_id   = id;
+      _blocks.write( vec.data(), vec.size() );
+   });
+
+   if( _use_mmap && ( uint64_t(_blocks.tellp()) - _blocks_mapped >= unmapped_tail_limit
+                      || _index_bytes - _index_mapped >= unmapped_tail_limit ) )
+      map_files();
+}
+
+template<typename Fill>
+void block_database::write_index_entry( uint64_t index_pos, Fill&& fill )
+{
    index_entry e;
-   _blocks.seekp( 0, _blocks.end );
-   auto vec = fc::raw::pack( b );
-   e.block_pos  = _blocks.tellp();
-   e.block_size = vec.size();
-   e.block_id   = id;
-   _blocks.write( vec.data(), vec.size() );
+   fill( e );
+   _block_num_to_pos.seekp( index_pos );
    _block_num_to_pos.write( (char*)&e, sizeof(e) );
+   _index_bytes = std::max<uint64_t>( _index_bytes, index_pos + sizeof(e) );
+   // the mapping only sees what reached the file, entries in the tail are read back through the stream
+   if( index_pos < _index_mapped )
+      _block_num_to_pos.flush();
+}
+
+uint64_t block_database::index_size()const
+{
+   if( _use_mmap )
+      return _index_bytes;
+   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
+   return _block_num_to_pos.tellg();
+}
+
+void block_database::read_index_entry( uint64_t index_pos, index_entry& e )const
+{
+   assert( _owner == &fc::thread::current() );
+   if( index_pos + sizeof(e) <= _index_mapped )
+   {
+      std::memcpy( &e, static_cast<const char*>( _index_region->get_address() ) + index_pos, sizeof(e) );
+      return;
+   }
+   _block_num_to_pos.seekg( index_pos );
+   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+}
+
+signed_block block_database::read_block( const index_entry& e )const
+{
+   assert( _owner == &fc::thread::current() );
+   if( e.block_pos + e.block_size <= _blocks_mapped )
+   {
+      fc::datastream<const char*> ds( static_cast<const char*>( _blocks_region->get_address() ) + e.block_pos, e.block_size );
+      signed_block result;
+      fc::raw::unpack( ds, result );
+      return result;
+   }
+   vector<char> data( e.block_size );
+   _blocks.seekg( e.block_pos );
+   if( e.block_size )
+      _blocks.read( data.data(), e.block_size );
+   return fc::raw::unpack<signed_block>( data );
 }
 
 void block_database::remove( const block_id_type& id )
 { try {
+   assert( _owner == &fc::thread::current() );
    index_entry e;
    auto index_pos = sizeof(e)*block_header::num_from_id(id);
-   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-   if ( _block_num_to_pos.tellg() <= index_pos )
+   if ( index_size() <= index_pos )
       FC_THROW_EXCEPTION(fc::key_not_found_exception, "Block ${id} not contained in block database", ("id", id));
 
-   _block_num_to_pos.seekg( index_pos );
-   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+   read_index_entry( index_pos, e );
 
    if( e.block_id == id )
-   {
-      e.block_size = 0;
-      _block_num_to_pos.seekp( sizeof(e)*block_header::num_from_id(id) );
-      _block_num_to_pos.write( (char*)&e, sizeof(e) );
-   }
+      write_index_entry( index_pos, [&]( index_entry& removed ) {
+         removed = e;
+         removed.block_size = 0;
+      });
 } FC_CAPTURE_AND_RETHROW( (id) ) }
 
 bool block_database::contains( const block_id_type& id )const
@@ -120,11 +218,9 @@ bool block_database::contains( const block_id_type& id )const
 
    index_entry e;
    auto index_pos = sizeof(e)*block_header::num_from_id(id);
-   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-   if ( _block_num_to_pos.tellg() <= index_pos )
+   if ( index_size() <= index_pos )
       return false;
-   _block_num_to_pos.seekg( index_pos );
-   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+   read_index_entry( index_pos, e );
 
    return e.block_id == id && e.block_size > 0;
 }
@@ -134,12 +230,10 @@ block_id_type block_database::fetch_block_id( uint32_t block_num )const
    assert( block_num != 0 );
    index_entry e;
    auto index_pos = sizeof(e)*block_num;
-   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-   if ( _block_num_to_pos.tellg() <= int64_t(index_pos) )
+   if ( index_size() <= index_pos )
       FC_THROW_EXCEPTION(fc::key_not_found_exception, "Block number ${block_num} not contained in block database", ("block_num", block_num));
 
-   _block_num_to_pos.seekg( index_pos );
-   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+   read_index_entry( index_pos, e );
 
    FC_ASSERT( e.block_id != block_id_type(), "Empty block_id in block_database (maybe corrupt on disk?)" );
    return e.block_id;
@@ -151,20 +245,14 @@ optional<signed_block> block_database::fetch_optional( const block_id_type& id )
    {
       index_entry e;
       auto index_pos = sizeof(e)*block_header::num_from_id(id);
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
+      if ( index_size() <= index_pos )
          return {};
 
-      _block_num_to_pos.seekg( index_pos );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
+      read_index_entry( index_pos, e );
 
       if( e.block_id != id ) return optional<signed_block>();
 
-      vector<char> data( e.block_size );
-      _blocks.seekg( e.block_pos );
-      if (e.block_size)
-         _blocks.read( data.data(), e.block_size );
-      auto result = fc::raw::unpack<signed_block>(data);
+      auto result = read_block( e );
       FC_ASSERT( result.id() == e.block_id );
       return result;
    }
@@ -183,17 +271,12 @@ optional<signed_block> block_database::fetch_by_number( uint32_t block_num )cons
    {
       index_entry e;
       auto index_pos = sizeof(e)*block_num;
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
+      if ( index_size() <= index_pos )
          return {};
 
-      _block_num_to_pos.seekg( index_pos, _block_num_to_pos.beg );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
+      read_index_entry( index_pos, e );
 
-      vector<char> data( e.block_size );
-      _blocks.seekg( e.block_pos );
-      _blocks.read( data.data(), e.block_size );
-      auto result = fc::raw::unpack<signed_block>(data);
+      auto result = read_block( e );
       FC_ASSERT( result.id() == e.block_id );
       return result;
    }
@@ -211,29 +294,23 @@ optional<signed_block> block_database::last()const
    try
    {
       index_entry e;
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
+      uint64_t pos = index_size();
 
-      if( _block_num_to_pos.tellp() < sizeof(index_entry) )
+      if( pos < sizeof(index_entry) )
          return optional<signed_block>();
 
-      _block_num_to_pos.seekg( -sizeof(index_entry), _block_num_to_pos.end );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
-      uint64_t pos = _block_num_to_pos.tellg();
+      pos -= sizeof(index_entry);
+      read_index_entry( pos, e );
       while( e.block_size == 0 && pos > 0 )
       {
          pos -= sizeof(index_entry);
-         _block_num_to_pos.seekg( pos );
-         _block_num_to_pos.read( (char*)&e, sizeof(e) );
+         read_index_entry( pos, e );
       }
 
       if( e.block_size == 0 )
          return optional<signed_block>();
 
-      vector<char> data( e.block_size );
-      _blocks.seekg( e.block_pos );
-      _blocks.read( data.data(), e.block_size );
-      auto result = fc::raw::unpack<signed_block>(data);
-      return result;
+      return read_block( e );
    }
    catch (const fc::exception&)
    {
@@ -249,19 +326,17 @@ optional<block_id_type> block_database::last_id()const
    try
    {
       index_entry e;
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
+      uint64_t pos = index_size();
 
-      if( _block_num_to_pos.tellp() < sizeof(index_entry) )
+      if( pos < sizeof(index_entry) )
          return optional<block_id_type>();
 
-      _block_num_to_pos.seekg( -sizeof(index_entry), _block_num_to_pos.end );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
-      uint64_t pos = _block_num_to_pos.tellg();
+      pos -= sizeof(index_entry);
+      read_index_entry( pos, e );
       while( e.block_size == 0 && pos > 0 )
       {
          pos -= sizeof(index_entry);
-         _block_num_to_pos.seekg( pos );
-         _block_num_to_pos.read( (char*)&e, sizeof(e) );
+         read_index_entry( pos, e );
       }
 
       if( e.block_size == 0 )
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2017 AssetFun, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/coin_evaluator.hpp>
+#include <graphene/chain/coin_object.hpp>
+#include <graphene/chain/exceptions.hpp>
+#include <graphene/chain/hardfork.hpp>
+
+namespace graphene { namespace chain {
+
+void_result coin_feed_price_batch_evaluator::do_evaluate( const coin_feed_price_batch_operation& o )
+{ try {
+   const database& d = db();
+   FC_ASSERT( d.head_block_time() >= HARDFORK_COIN_FEED_BATCH_TIME, "coin_feed_price_batch_operation is not allowed yet" );
+
+   _coins.clear();
+   _coins.reserve( o.feeds.size() );
+   for( const auto& feed : o.feeds )
+   {
+      const coin_object& coin = feed.coin_id( d );
+      FC_ASSERT( coin.feeders.count( o.publisher ), "${p} is not a feeder of ${c}",
+                 ("p", o.publisher)("c", coin.platform_quote_base) );
+      FC_ASSERT( coin.platform_quote_base.find( ':' ) != string::npos );
+      d.assert_coin_prices_not_compacted( coin, feed.prices );
+
+      // same as coin_feed_price_operation: unless resetting, each minute follows the latest one fed or repeats it
+      if( !feed.reset_price )
+      {
+         uint32_t latest = coin.dynamic_data( d ).latest_feed_time;
+         for( const auto& price : feed.prices )
+         {
+            GRAPHENE_ASSERT( latest == 0 || price.first == latest || price.first == latest + 60, coin_feed_price_not_continuous,
+                             "price of ${c} at ${t} does not follow the latest feed at ${l}",
+                             ("c", coin.platform_quote_base)("t", price.first)("l", latest) );
+            latest = price.first;
+         }
+      }
+      _coins.push_back( &coin );
+   }
+
+   return void_result();
+} FC_CAPTURE_AND_RETHROW( (o) ) }
+
+void_result coin_feed_price_batch_evaluator::do_apply( const coin_feed_price_batch_operation& o )
+{ try {
+   database& d = db();
+
+   for( size_t i = 0; i < o.feeds.size(); ++i )
+   {
+      const auto& feed = o.feeds[i];
+      const coin_object& coin = *_coins[i];
+      auto pos = coin.platform_quote_base.find( ':' );
+      string platform_id = coin.platform_quote_base.substr( 0, pos );
+      string quote_base  = coin.platform_quote_base.substr( pos + 1 );
+
+      d.modify( coin.dynamic_data( d ), [&]( coin_dynamic_data_object& dynamic ) {
+         for( const auto& price : feed.prices )
+            dynamic.feed_price( o.publisher, platform_id, quote_base, price.first, price.second, d, feed.reset_price );
+      });
+   }
+
+   return void_result();
+} FC_CAPTURE_AND_RETHROW( (o) ) }
+
+} } // graphene::chain
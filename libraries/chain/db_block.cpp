@@ -27,6 +27,7 @@
 #include <graphene/chain/hardfork.hpp>
 
 #include <graphene/chain/block_summary_object.hpp>
+#include <graphene/chain/coin_object.hpp>
 #include <graphene/chain/global_property_object.hpp>
 #include <graphene/chain/operation_history_object.hpp>
 
@@ -37,8 +38,12 @@
 #include <graphene/chain/exceptions.hpp>
 #include <graphene/chain/evaluator.hpp>
 
+#include <fc/scoped_exit.hpp>
 #include <fc/smart_ref_impl.hpp>
 
+#include <future>
+#include <thread>
+
 namespace graphene { namespace chain {
 
 bool database::is_known_block( const block_id_type& id )const
@@ -69,6 +74,27 @@ optional<signed_block> database::fetch_block_by_id( const block_id_type& id )con
    return b->data;
 }
 
+packed_block_ptr database::fetch_packed_block_by_id( const block_id_type& id )const
+{
+   return _block_cache.fetch_by_id( id );
+}
+
+packed_block_ptr database::fetch_packed_block_by_number( uint32_t num )const
+{
+   return _block_cache.fetch_by_number( num );
+}
+
+optional<signed_block_header> database::fetch_block_header_by_number( uint32_t num )const
+{
+   auto header = _block_cache.fetch_header_by_number( num );
+   if( header )
+      return header;
+   auto b = fetch_block_by_number( num );
+   if( b )
+      return signed_block_header( *b );
+   return optional<signed_block_header>();
+}
+
 optional<signed_block> database::fetch_block_by_number( uint32_t num )const
 {
    auto results = _fork_db.fetch_block_by_number(num);
@@ -114,6 +140,9 @@ std::vector<block_id_type> database::get_block_ids_on_fork(block_id_type head_of
 bool database::push_block(const signed_block& new_block, uint32_t skip)
 {
 //   idump((new_block.block_num())(new_block.id())(new_block.timestamp)(new_block.previous));
+   if( !(skip & (skip_transaction_signatures | skip_authority_check)) )
+      precompute_signature_keys( new_block );
+   write_access writing( *this );
    bool result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -123,9 +152,68 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
          result = _push_block(new_block);
       });
    });
+   if( head_block_id() == new_block.id() )
+      _block_cache.insert( new_block );
    return result;
 }
 
+void database::precompute_signature_keys( const signed_block& b )
+{
+   // a single transaction is recovered just as fast by the apply itself
+   if( b.transactions.size() < 2 )
+      return;
+
+   // joined without yielding, since generate_block() calls this through push_block() while holding write access
+   chain_id_type chain_id = get_chain_id();
+   size_t count = std::max<size_t>( 1, std::min<size_t>( 4, std::thread::hardware_concurrency() ) );
+   vector<std::future<void>> done;
+   for( size_t t = 0; t < count; ++t )
+   {
+      done.push_back( std::async( std::launch::async, [&b, chain_id, t, count]() {
+         for( size_t i = t; i < b.transactions.size(); i += count )
+         {
+            const auto& trx = b.transactions[i];
+            digest_type d = trx.sig_digest( chain_id );
+            for( const auto& sig : trx.signatures )
+            {
+               // invalid signatures are reported by the serial apply
+               try { recover_signature_key( d, sig ); } catch( const fc::exception& ) {}
+            }
+         }
+      }) );
+   }
+   for( auto& f : done )
+      f.get();
+}
+
+void database::lock_state_for_write()
+{
+   // nothing has been changed yet, so other tasks may run while the readers already started finish
+   ++_writes_pending;
+   try {
+      while( !_state_lock.try_lock() )
+         fc::usleep( fc::microseconds( 100 ) );
+   } catch( ... ) {
+      --_writes_pending;
+      throw;
+   }
+   --_writes_pending;
+   _write_owner.reset( new bool( true ) );
+}
+
+void database::unlock_state_for_write()
+{
+   _write_owner.reset();
+   _state_lock.unlock();
+}
+
+void database::set_read_worker_threads( uint32_t count )
+{
+   _read_threads.clear();
+   for( uint32_t i = 0; i < count; ++i )
+      _read_threads.push_back( std::make_shared<fc::thread>( "api_read_" + fc::to_string( uint64_t(i) ) ) );
+}
+
 bool database::_push_block(const signed_block& new_block)
 { try {
    uint32_t skip = get_node_properties().skip_flags;
@@ -218,6 +306,7 @@ bool database::_push_block(const signed_block& new_block)
  */
 processed_transaction database::push_transaction( const signed_transaction& trx, uint32_t skip )
 { try {
+   write_access writing( *this );
    processed_transaction result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -304,6 +393,7 @@ signed_block database::generate_block(
    uint32_t skip /* = 0 */
    )
 { try {
+   write_access writing( *this );
    signed_block result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -420,6 +510,7 @@ signed_block database::_generate_block(
  */
 void database::pop_block()
 { try {
+   write_access writing( *this );
    _pending_tx_session.reset();
    auto head_id = head_block_id();
    optional<signed_block> head_block = fetch_block_by_id( head_id );
@@ -427,6 +518,7 @@ void database::pop_block()
 
    _fork_db.pop_block();
    _block_id_to_block.remove( head_id );
+   _block_cache.remove( head_id );
    pop_undo();
 
    _popped_tx.insert( _popped_tx.begin(), head_block->transactions.begin(), head_block->transactions.end() );
@@ -435,6 +527,7 @@ void database::pop_block()
 
 void database::clear_pending()
 { try {
+   write_access writing( *this );
    assert( (_pending_tx.size() == 0) || _pending_tx_session.valid() );
    _pending_tx.clear();
    _pending_tx_session.reset();
@@ -504,16 +597,24 @@ void database::_apply_block( const signed_block& next_block )
    _current_block_num    = next_block_num;
    _current_trx_in_block = 0;
 
-   for( const auto& trx : next_block.transactions )
+   _applying_block = true;
+   auto applying_guard = fc::make_scoped_exit( [this]() { _applying_block = false; } );
+   block_apply_stats* block_stats = _performance_stats.enabled ? &_performance_stats.blocks : nullptr;
+   scoped_latency total_timer( block_stats ? &block_stats->total : nullptr );
+
    {
-      /* We do not need to push the undo state for each transaction
-       * because they either all apply and are valid or the
-       * entire block fails to apply.  We only need an "undo" state
-       * for transactions when validating broadcast transactions or
-       * when building a block.
-       */
-      apply_transaction( trx, skip );
-      ++_current_trx_in_block;
+      scoped_latency trx_timer( block_stats ? &block_stats->transactions : nullptr );
+      for( const auto& trx : next_block.transactions )
+      {
+         /* We do not need to push the undo state for each transaction
+          * because they either all apply and are valid or the
+          * entire block fails to apply.  We only need an "undo" state
+          * for transactions when validating broadcast transactions or
+          * when building a block.
+          */
+         apply_transaction( trx, skip );
+         ++_current_trx_in_block;
+      }
    }
 
    update_global_dynamic_data(next_block);
@@ -522,7 +623,10 @@ void database::_apply_block( const signed_block& next_block )
 
    // Are we at the maintenance interval?
    if( maint_needed )
+   {
+      scoped_latency maint_timer( block_stats ? &block_stats->maintenance : nullptr );
       perform_chain_maintenance(next_block, global_props);
+   }
 
    create_block_summary(next_block);
    clear_expired_transactions();
@@ -531,8 +635,14 @@ void database::_apply_block( const signed_block& next_block )
    update_expired_feeds();
    update_withdraw_permissions();
    // for subject fsm transistion
-   expire_subject_event();
-   expire_token_event();
+   {
+      scoped_latency subject_timer( block_stats ? &block_stats->expire_subject_event : nullptr );
+      expire_subject_event();
+   }
+   {
+      scoped_latency token_timer( block_stats ? &block_stats->expire_token_event : nullptr );
+      expire_token_event();
+   }
 
    // n.b., update_maintenance_flag() happens this late
    // because get_slot_time() / get_slot_at_time() is needed above
@@ -548,9 +658,55 @@ void database::_apply_block( const signed_block& next_block )
    applied_block( next_block ); //emit
    _applied_ops.clear();
 
-   notify_changed_objects();
+   {
+      scoped_latency notify_timer( block_stats ? &block_stats->notify_changed_objects : nullptr );
+      notify_changed_objects();
+   }
+
+   if( _performance_dump_interval != 0 && next_block_num % _performance_dump_interval == 0 )
+      dump_performance_stats();
 } FC_CAPTURE_AND_RETHROW( (next_block.block_num()) )  }
 
+void database::reset_performance_stats()
+{
+   bool enabled = _performance_stats.enabled;
+   _performance_stats = performance_stats();
+   _performance_stats.enabled = enabled;
+}
+
+operation_stats* database::block_operation_stats( int which )
+{
+   return _performance_stats.enabled && _applying_block ? &_performance_stats.get_operation( which ) : nullptr;
+}
+
+void database::dump_performance_stats()const
+{
+   const auto& b = _performance_stats.blocks;
+   ilog( "performance: ${n} blocks, ${t}us total, transactions ${trx}us, maintenance ${m}us, "
+         "expire_subject_event ${s}us, expire_token_event ${k}us, notify_changed_objects ${c}us",
+         ("n",b.total.count)("t",b.total.total_us)("trx",b.transactions.total_us)("m",b.maintenance.total_us)
+         ("s",b.expire_subject_event.total_us)("k",b.expire_token_event.total_us)("c",b.notify_changed_objects.total_us) );
+
+   vector<int> ops;
+   for( size_t i = 0; i < _performance_stats.operations.size(); ++i )
+      if( _performance_stats.operations[i].evaluate.count > 0 )
+         ops.push_back( int(i) );
+   auto op_total = [&]( int i ) {
+      const auto& s = _performance_stats.operations[i];
+      return s.evaluate.total_us + s.apply.total_us;
+   };
+   std::sort( ops.begin(), ops.end(), [&]( int a, int b ) { return op_total( a ) > op_total( b ); } );
+   if( ops.size() > 10 )
+      ops.resize( 10 );
+   for( int i : ops )
+   {
+      const auto& s = _performance_stats.operations[i];
+      ilog( "performance: ${op} x${n}, evaluate ${e}us (max ${em}us), apply ${a}us (max ${am}us), failed ${f}, undo entries ${u}",
+            ("op",operation_type_name( i ))("n",s.evaluate.count)("e",s.evaluate.total_us)("em",s.evaluate.max_us)
+            ("a",s.apply.total_us)("am",s.apply.max_us)("f",s.failed)("u",s.undo_entries) );
+   }
+}
+
 
 
 processed_transaction database::apply_transaction(const signed_transaction& trx, uint32_t skip)
@@ -573,7 +729,7 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
    auto& trx_idx = get_mutable_index_type<transaction_index>();
    const chain_id_type& chain_id = get_chain_id();
    auto trx_id = trx.id();
-   ilog( "_apply_transaction: ${trx_id}", ("trx_id", trx_id) );
+   tlog( "_apply_transaction: ${trx_id}", ("trx_id", trx_id) );
    FC_ASSERT( (skip & skip_transaction_dupe_check) ||
               trx_idx.indices().get<by_trx_id>().find(trx_id) == trx_idx.indices().get<by_trx_id>().end() );
    transaction_evaluation_state eval_state(this);
@@ -614,7 +770,7 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
          transaction.trx = trx;
       });
 
-      ilog( "_apply_transaction create transaction: ${trx_id}", ("trx_id", trx_id) );
+      tlog( "_apply_transaction create transaction: ${trx_id}", ("trx_id", trx_id) );
    }
 
    eval_state.operation_results.reserve(trx.operations.size());
@@ -640,7 +796,7 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
 operation_result database::apply_operation(transaction_evaluation_state& eval_state, const operation& op)
 { try {
   #ifdef LOG_DEBUG
-      ilog("apply operation: ${op}", ("op", op));
+      tlog("apply operation: ${op}", ("op", op));
   #endif
    int i_which = op.which();
    uint64_t u_which = uint64_t( i_which );
@@ -651,9 +807,39 @@ operation_result database::apply_operation(transaction_evaluation_state& eval_st
    unique_ptr<op_evaluator>& eval = _operation_evaluators[ u_which ];
    if( !eval )
       assert( "No registered evaluator for this operation" && false );
+   operation_stats* op_stats = block_operation_stats( i_which );
+   auto undo_entries = [this]() -> size_t {
+      if( _undo_db.size() == 0 )
+         return 0;
+      const auto& state = _undo_db.head();
+      return state.old_values.size() + state.new_ids.size() + state.removed.size();
+   };
+   size_t undo_depth = _undo_db.size();
+   size_t undo_before = op_stats ? undo_entries() : 0;
+
    auto op_id = push_applied_operation( op );
-   auto result = eval->evaluate( eval_state, op, true );
+   operation_result result;
+   try {
+      // the single feed evaluator knows nothing about compacted days, refuse them here for every feed path
+      if( i_which == operation::tag<coin_feed_price_operation>::value )
+      {
+         const auto& feed = op.get<coin_feed_price_operation>();
+         assert_coin_prices_not_compacted( feed.coin_id( *this ), feed.prices );
+      }
+      result = eval->evaluate( eval_state, op, true );
+   } catch( ... ) {
+      if( op_stats )
+         ++op_stats->failed;
+      throw;
+   }
    set_applied_operation_result( op_id, result );
+
+   if( op_stats && _undo_db.size() == undo_depth )
+   {
+      size_t undo_after = undo_entries();
+      if( undo_after > undo_before )
+         op_stats->undo_entries += undo_after - undo_before;
+   }
    return result;
 } FC_CAPTURE_AND_RETHROW( (op) ) }
 
@@ -28,6 +28,7 @@
 #include <graphene/chain/chain_property_object.hpp>
 #include <graphene/chain/global_property_object.hpp>
 #include <graphene/chain/coin_object.hpp>
+#include <graphene/chain/hardfork.hpp>
 #include <graphene/chain/module_cfg_object.hpp>
 
 #include <fc/smart_ref_impl.hpp>
@@ -113,13 +114,52 @@ coin_price database::get_coin_price(const string& platform_id, const string& quo
 	   return coin_price();
    }
    const coin_object& coin = *itr;
-   //TODO 根据时间比较，看是从fixed_data还是从dynamic_data读取价格。目前简单做，先从dynamic_data取，后面优化
+   //先从dynamic_data取(可能被重置)，取不到再查已压缩的历史价格
    coin_dynamic_data_id_type dyn_id = coin.dynamic_coin_data_id;
    auto it_dyn = find(dyn_id);
    FC_ASSERT(it_dyn, "coin dynamic data not found for ${platform_id}:${quote_base}, dyn_id: ${dyn_id}", ("platform_id", platform_id)("quote_base", quote_base)("dyn_id", dyn_id));
    FC_ASSERT(time_second % 60 == 0, "time in second not aligned to 60");
    const coin_dynamic_data_object& dyn_data = *it_dyn;
-   return dyn_data.get_coin_price(platform_id, quote_base, time_second, *this);
+   coin_price result = dyn_data.get_coin_price(platform_id, quote_base, time_second, *this);
+   if (!result.valid())
+   {
+      optional<share_type> compacted = find_compacted_coin_price(coin.id, time_second);
+      if (compacted.valid())
+         result = coin_price(platform_id, quote_base, *compacted);
+   }
+   return result;
+}
+
+optional<share_type> database::find_compacted_coin_price(coin_id_type coin, uint32_t time_second)const
+{
+   const auto& buckets = get_index_type<coin_price_bucket_index>().indices().get<by_coin_time>();
+   auto itr = buckets.find(boost::make_tuple(coin, coin_price_bucket_object::bucket_start(time_second)));
+   if (itr == buckets.end())
+      return optional<share_type>();
+   share_type price = itr->prices[coin_price_bucket_object::bucket_slot(time_second)];
+   if (price == INVALID_FEED_PRICE)
+      return optional<share_type>();
+   return price;
+}
+
+bool database::is_coin_price_compacted(const coin_object& coin, uint32_t time_second)const
+{
+   // before the hardfork no day object is ever removed, so a missing day has just not been fed
+   if (head_block_time() < HARDFORK_COIN_PRICE_BUCKET_TIME)
+      return false;
+   const coin_dynamic_data_object& dyn = coin.dynamic_data(*this);
+   uint32_t day = time_second - time_second % PRICE_DATA_DIVIDE_INTERVAL;
+   uint32_t feeding_day = dyn.latest_feed_time - dyn.latest_feed_time % PRICE_DATA_DIVIDE_INTERVAL;
+   return day < feeding_day && dyn.prices.find(day) == dyn.prices.end();
+}
+
+void database::assert_coin_prices_not_compacted(const coin_object& coin, const map<uint32_t, share_type>& prices)const
+{
+   if (head_block_time() < HARDFORK_COIN_PRICE_BUCKET_TIME)
+      return;
+   for (const auto& price : prices)
+      FC_ASSERT(!is_coin_price_compacted(coin, price.first), "price of ${c} at ${t} is already compacted",
+                ("c", coin.platform_quote_base)("t", price.first));
 }
 
 std::pair<uint32_t, coin_price> database::get_latest_valid_price(const string& platform_id, const string& quote_base)const
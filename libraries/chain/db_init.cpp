@@ -206,6 +206,7 @@ void database::initialize_evaluators()
    register_evaluator<subject_event_evaluator>();
 
    register_evaluator<coin_feed_price_evaluator>();
+   register_evaluator<coin_feed_price_batch_evaluator>();
    register_evaluator<module_cfg_evaluator>();
    register_evaluator<token_publish_evaluator>();
    register_evaluator<token_buy_evaluator>();
@@ -250,12 +251,14 @@ void database::initialize_indexes()
    add_index< primary_index<coin_dynamic_data_index> >();
    add_index< primary_index<coin_fixed_data_index> >();
    add_index< primary_index<coin_price_data_index> >();
+   add_index< primary_index<coin_price_bucket_index> >();
 
    add_index< primary_index<module_cfg_index> >();
 
    //Implementation object indexes
    add_index< primary_index<transaction_index                             > >();
-   add_index< primary_index<account_balance_index                         > >();
+   auto bal_index = add_index< primary_index<account_balance_index        > >();
+   bal_index->add_secondary_index<asset_holder_index>();
    add_index< primary_index<asset_bitasset_data_index                     > >();
    add_index< primary_index<simple_index<global_property_object          >> >();
    add_index< primary_index<simple_index<dynamic_global_property_object  >> >();
@@ -280,7 +283,8 @@ void database::initialize_indexes()
    add_index< primary_index< token_buy_index                           > >();
    add_index< primary_index< token_event_index                          > >();
    //word
-   add_index< primary_index< word_index                           > >();
+   auto word_idx = add_index< primary_index< word_index                           > >();
+   word_idx->add_secondary_index<sensitive_word_index>();
 
 
 }
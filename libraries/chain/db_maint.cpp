@@ -27,6 +27,9 @@
 #include <fc/smart_ref_impl.hpp>
 #include <fc/uint128.hpp>
 
+#include <future>
+#include <thread>
+
 #include <graphene/chain/database.hpp>
 #include <graphene/chain/fba_accumulator_id.hpp>
 #include <graphene/chain/hardfork.hpp>
@@ -34,6 +37,7 @@
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/chain/budget_record_object.hpp>
+#include <graphene/chain/coin_object.hpp>
 #include <graphene/chain/buyback_object.hpp>
 #include <graphene/chain/chain_property_object.hpp>
 #include <graphene/chain/committee_member_object.hpp>
@@ -716,6 +720,73 @@ void deprecate_annual_members( database& db )
    return;
 }
 
+void database::compact_coin_prices()
+{
+   const auto& buckets = get_index_type<coin_price_bucket_index>().indices().get<by_coin_time>();
+
+   for( const coin_object& coin : get_index_type<coin_index>().indices() )
+   {
+      // <bucket start, <slot, price>>, written with one create or modify per bucket
+      map< uint32_t, vector< std::pair<uint32_t, share_type> > > pending;
+      auto collect = [&]( uint32_t time, share_type price )
+      {
+         if( price != INVALID_FEED_PRICE )
+            pending[coin_price_bucket_object::bucket_start( time )].emplace_back( coin_price_bucket_object::bucket_slot( time ), price );
+      };
+
+      const coin_fixed_data_object* fixed = find( coin.fixed_coin_data_id );
+      if( fixed && !fixed->price_fixed.empty() )
+      {
+         for( const auto& p : fixed->price_fixed )
+            collect( p.first, p.second.price );
+         modify( *fixed, []( coin_fixed_data_object& f ) { f.price_fixed.clear(); });
+      }
+
+      const coin_dynamic_data_object* dyn = find( coin.dynamic_coin_data_id );
+      if( dyn && dyn->latest_feed_time != 0 )
+      {
+         // the day still being fed may get more prices, leave it alone
+         uint32_t feeding_day = dyn->latest_feed_time - dyn->latest_feed_time % PRICE_DATA_DIVIDE_INTERVAL;
+         vector<uint32_t> compacted;
+         for( const auto& day : dyn->prices )
+         {
+            const coin_price_data_object* data = find( day.second );
+            if( data && !data->price_feeding.empty() && data->price_feeding.rbegin()->first >= feeding_day )
+               continue;
+            if( data )
+            {
+               for( const auto& p : data->price_feeding )
+                  collect( p.first, p.second.price );
+               remove( *data );
+            }
+            compacted.push_back( day.first );
+         }
+         if( !compacted.empty() )
+            modify( *dyn, [&]( coin_dynamic_data_object& d ) {
+               for( uint32_t t : compacted )
+                  d.prices.erase( t );
+            });
+      }
+
+      for( const auto& entry : pending )
+      {
+         auto fill = [&]( coin_price_bucket_object& b ) {
+            for( const auto& slot : entry.second )
+               b.prices[slot.first] = slot.second;
+         };
+         auto itr = buckets.find( boost::make_tuple( coin.id, entry.first ) );
+         if( itr != buckets.end() )
+            modify( *itr, fill );
+         else
+            create<coin_price_bucket_object>( [&]( coin_price_bucket_object& b ) {
+               b.coin = coin.id;
+               b.start = entry.first;
+               fill( b );
+            });
+      }
+   }
+}
+
 void database::perform_chain_maintenance(const signed_block& next_block, const global_property_object& global_props)
 {
    const auto& gpo = get_global_properties();
@@ -726,84 +797,171 @@ void database::perform_chain_maintenance(const signed_block& next_block, const g
    struct vote_tally_helper {
       database& d;
       const global_property_object& props;
+      vector<uint64_t> vote_tally;
+      vector<uint64_t> witness_count_histogram;
+      vector<uint64_t> committee_count_histogram;
+      uint64_t total_voting_stake = 0;
 
       vote_tally_helper(database& d, const global_property_object& gpo)
-         : d(d), props(gpo)
-      {
-         d._vote_tally_buffer.resize(props.next_available_vote_id);
-         d._witness_count_histogram_buffer.resize(props.parameters.maximum_witness_count / 2 + 1);
-         d._committee_count_histogram_buffer.resize(props.parameters.maximum_committee_count / 2 + 1);
-         d._total_voting_stake = 0;
+         : d(d), props(gpo),
+           vote_tally(props.next_available_vote_id),
+           witness_count_histogram(props.parameters.maximum_witness_count / 2 + 1),
+           committee_count_histogram(props.parameters.maximum_committee_count / 2 + 1)
+      {}
+
+      bool counts(const account_object& stake_account)const {
+         return props.parameters.count_non_member_votes || stake_account.is_member(d.head_block_time());
+      }
+
+      uint64_t voting_stake(const account_object& stake_account)const {
+         const auto& stats = stake_account.statistics(d);
+         return stats.total_core_in_orders.value
+               + (stake_account.cashback_vb.valid() ? (*stake_account.cashback_vb)(d).balance.amount.value: 0)
+               + d.get_balance(stake_account.get_id(), asset_id_type()).amount.value;
       }
 
       void operator()(const account_object& stake_account) {
-         if( props.parameters.count_non_member_votes || stake_account.is_member(d.head_block_time()) )
-         {
-            // There may be a difference between the account whose stake is voting and the one specifying opinions.
-            // Usually they're the same, but if the stake account has specified a voting_account, that account is the one
-            // specifying the opinions.
-            const account_object& opinion_account =
-                  (stake_account.options.voting_account ==
-                   GRAPHENE_PROXY_TO_SELF_ACCOUNT)? stake_account
-                                     : d.get(stake_account.options.voting_account);
-
-            const auto& stats = stake_account.statistics(d);
-            uint64_t voting_stake = stats.total_core_in_orders.value
-                  + (stake_account.cashback_vb.valid() ? (*stake_account.cashback_vb)(d).balance.amount.value: 0)
-                  + d.get_balance(stake_account.get_id(), asset_id_type()).amount.value;
-
-            for( vote_id_type id : opinion_account.options.votes )
-            {
-               uint32_t offset = id.instance();
-               // if they somehow managed to specify an illegal offset, ignore it.
-               if( offset < d._vote_tally_buffer.size() )
-                  d._vote_tally_buffer[offset] += voting_stake;
-            }
+         if( counts(stake_account) )
+            add(stake_account, voting_stake(stake_account));
+      }
 
-            if( opinion_account.options.num_witness <= props.parameters.maximum_witness_count )
-            {
-               uint16_t offset = std::min(size_t(opinion_account.options.num_witness/2),
-                                          d._witness_count_histogram_buffer.size() - 1);
-               // votes for a number greater than maximum_witness_count
-               // are turned into votes for maximum_witness_count.
-               //
-               // in particular, this takes care of the case where a
-               // member was voting for a high number, then the
-               // parameter was lowered.
-               d._witness_count_histogram_buffer[offset] += voting_stake;
-            }
-            if( opinion_account.options.num_committee <= props.parameters.maximum_committee_count )
-            {
-               uint16_t offset = std::min(size_t(opinion_account.options.num_committee/2),
-                                          d._committee_count_histogram_buffer.size() - 1);
-               // votes for a number greater than maximum_committee_count
-               // are turned into votes for maximum_committee_count.
-               //
-               // same rationale as for witnesses
-               d._committee_count_histogram_buffer[offset] += voting_stake;
-            }
+      /// Buffers wrap modulo 2^64, so a negative stake change may be passed as its two's complement
+      void add(const account_object& stake_account, uint64_t voting_stake) {
+         // There may be a difference between the account whose stake is voting and the one specifying opinions.
+         // Usually they're the same, but if the stake account has specified a voting_account, that account is the one
+         // specifying the opinions.
+         const account_object& opinion_account =
+               (stake_account.options.voting_account ==
+                GRAPHENE_PROXY_TO_SELF_ACCOUNT)? stake_account
+                                  : d.get(stake_account.options.voting_account);
+
+         for( vote_id_type id : opinion_account.options.votes )
+         {
+            uint32_t offset = id.instance();
+            // if they somehow managed to specify an illegal offset, ignore it.
+            if( offset < vote_tally.size() )
+               vote_tally[offset] += voting_stake;
+         }
 
-            d._total_voting_stake += voting_stake;
+         if( opinion_account.options.num_witness <= props.parameters.maximum_witness_count )
+         {
+            uint16_t offset = std::min(size_t(opinion_account.options.num_witness/2),
+                                       witness_count_histogram.size() - 1);
+            // votes for a number greater than maximum_witness_count
+            // are turned into votes for maximum_witness_count.
+            //
+            // in particular, this takes care of the case where a
+            // member was voting for a high number, then the
+            // parameter was lowered.
+            witness_count_histogram[offset] += voting_stake;
+         }
+         if( opinion_account.options.num_committee <= props.parameters.maximum_committee_count )
+         {
+            uint16_t offset = std::min(size_t(opinion_account.options.num_committee/2),
+                                       committee_count_histogram.size() - 1);
+            // votes for a number greater than maximum_committee_count
+            // are turned into votes for maximum_committee_count.
+            //
+            // same rationale as for witnesses
+            committee_count_histogram[offset] += voting_stake;
          }
+
+         total_voting_stake += voting_stake;
       }
-   } tally_helper(*this, gpo);
+
+      void merge(const vote_tally_helper& other) {
+         for( size_t i = 0; i < vote_tally.size(); ++i )
+            vote_tally[i] += other.vote_tally[i];
+         for( size_t i = 0; i < witness_count_histogram.size(); ++i )
+            witness_count_histogram[i] += other.witness_count_histogram[i];
+         for( size_t i = 0; i < committee_count_histogram.size(); ++i )
+            committee_count_histogram[i] += other.committee_count_histogram[i];
+         total_voting_stake += other.total_voting_stake;
+      }
+   };
+
+   // Tallying only reads the object graph, so the accounts are split across threads, each with its own buffers.
+   // The join blocks this thread instead of yielding to other fc tasks, so nothing can touch the state meanwhile.
+   vector<const account_object*> accounts;
+   {
+      const auto& idx = get_index_type<account_index>().indices().get<by_name>();
+      accounts.reserve( idx.size() );
+      for( const account_object& a : idx )
+         accounts.push_back( &a );
+   }
+   size_t worker_count = 1;
+   if( accounts.size() >= GRAPHENE_PARALLEL_VOTE_TALLY_MIN_ACCOUNTS )
+      worker_count = std::max<size_t>( 1, std::min<size_t>( 4, std::thread::hardware_concurrency() ) );
+   vector<vote_tally_helper> tallies( worker_count, vote_tally_helper(*this, gpo) );
+   if( worker_count == 1 )
+   {
+      for( const account_object* a : accounts )
+         tallies[0]( *a );
+   }
+   else
+   {
+      vector<std::future<void>> done;
+      for( size_t t = 0; t < worker_count; ++t )
+      {
+         size_t begin = accounts.size() * t / worker_count;
+         size_t end = accounts.size() * (t + 1) / worker_count;
+         vote_tally_helper& tally = tallies[t];
+         done.push_back( std::async( std::launch::async, [&accounts, &tally, begin, end]() {
+            for( size_t i = begin; i < end; ++i )
+               tally( *accounts[i] );
+         }) );
+      }
+      for( auto& f : done )
+         f.get();
+      for( size_t t = 1; t < worker_count; ++t )
+         tallies[0].merge( tallies[t] );
+   }
+   vote_tally_helper& tally_helper = tallies[0];
+
+   // Fees used to be processed per account right after tallying it, so cashback paid by an account to one
+   // later in name order was part of that account's tally.  Keep that result by tallying the change.
    struct process_fees_helper {
       database& d;
       const global_property_object& props;
+      vote_tally_helper& tally;
 
-      process_fees_helper(database& d, const global_property_object& gpo)
-         : d(d), props(gpo) {}
+      process_fees_helper(database& d, const global_property_object& gpo, vote_tally_helper& tally)
+         : d(d), props(gpo), tally(tally) {}
 
       void operator()(const account_object& a) {
-         a.statistics(d).process_fees(a, d);
+         const auto& stats = a.statistics(d);
+         if( stats.pending_fees == 0 && stats.pending_vested_fees == 0 )
+            return;
+
+         flat_map<account_id_type, uint64_t> stakes;
+         for( account_id_type id : { a.lifetime_referrer, a.referrer, a.registrar } )
+         {
+            const account_object& payee = id(d);
+            if( payee.name > a.name && tally.counts(payee) )
+               stakes[id] = tally.voting_stake(payee);
+         }
+
+         stats.process_fees(a, d);
+
+         for( const auto& s : stakes )
+         {
+            const account_object& payee = s.first(d);
+            uint64_t change = tally.voting_stake(payee) - s.second;
+            if( change != 0 )
+               tally.add(payee, change);
+         }
       }
-   } fee_helper(*this, gpo);
+   } fee_helper(*this, gpo, tally_helper);
 
    perform_account_maintenance(std::tie(
-      tally_helper,
       fee_helper
       ));
 
+   _vote_tally_buffer = std::move(tally_helper.vote_tally);
+   _witness_count_histogram_buffer = std::move(tally_helper.witness_count_histogram);
+   _committee_count_histogram_buffer = std::move(tally_helper.committee_count_histogram);
+   _total_voting_stake = tally_helper.total_voting_stake;
+
    struct clear_canary {
       clear_canary(vector<uint64_t>& target): target(target){}
       ~clear_canary() { target.clear(); }
@@ -877,6 +1035,9 @@ void database::perform_chain_maintenance(const signed_block& next_block, const g
    for( const auto& d : get_index_type<asset_bitasset_data_index>().indices() )
       modify( d, [](asset_bitasset_data_object& o) { o.force_settled_volume = 0; });
 
+   if( head_block_time() >= HARDFORK_COIN_PRICE_BUCKET_TIME )
+      compact_coin_prices();
+
    // process_budget needs to run at the bottom because
    //   it needs to know the next_maintenance_time
    process_budget();
@@ -28,13 +28,88 @@
 #include <graphene/chain/protocol/fee_schedule.hpp>
 
 #include <fc/io/fstream.hpp>
+#include <fc/thread/thread.hpp>
 
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <thread>
 
 namespace graphene { namespace chain {
 
+namespace detail {
+
+   /**
+    * Reads, unpacks and merkle-checks blocks for reindex ahead of the apply loop.  Every worker thread has its
+    * own block_database handle, block i is always loaded by worker i % workers, and results are handed out
+    * strictly in block number order from a window of at most max_ahead blocks.
+    */
+   class block_prefetcher
+   {
+      public:
+         struct prefetched_block
+         {
+            optional<signed_block> block;
+            bool                   merkle_ok = false;
+         };
+
+         block_prefetcher( const fc::path& block_dir, uint32_t last_block_num )
+            : _last_block_num(last_block_num)
+         {
+            size_t workers = std::max( 1u, std::min( 4u, std::thread::hardware_concurrency() / 2 ) );
+            _readers.resize( workers );
+            for( size_t i = 0; i < workers; ++i )
+            {
+               _threads.emplace_back( new fc::thread( "reindex_" + fc::to_string( uint64_t(i) ) ) );
+               block_database* reader = &_readers[i];
+               _threads.back()->async( [reader, block_dir]{ reader->open( block_dir ); } ).wait();
+            }
+         }
+
+         ~block_prefetcher()
+         {
+            _pending.clear();
+            for( size_t i = 0; i < _threads.size(); ++i )
+            {
+               block_database* reader = &_readers[i];
+               _threads[i]->async( [reader]{ reader->close(); } ).wait();
+               _threads[i]->quit();
+            }
+         }
+
+         prefetched_block next()
+         {
+            while( _pending.size() < max_ahead && _next_to_schedule <= _last_block_num )
+            {
+               uint32_t num = _next_to_schedule++;
+               size_t worker = num % _threads.size();
+               block_database* reader = &_readers[worker];
+               _pending.push_back( _threads[worker]->async( [reader, num]() -> prefetched_block {
+                  prefetched_block result;
+                  result.block = reader->fetch_by_number( num );
+                  if( result.block.valid() )
+                     result.merkle_ok = result.block->transaction_merkle_root == result.block->calculate_merkle_root();
+                  return result;
+               }, "reindex_prefetch" ) );
+            }
+            FC_ASSERT( !_pending.empty() );
+            prefetched_block result = _pending.front().wait();
+            _pending.pop_front();
+            return result;
+         }
+
+      private:
+         static const size_t                      max_ahead = 512;
+         uint32_t                                 _last_block_num;
+         uint32_t                                 _next_to_schedule = 1;
+         std::vector<block_database>              _readers;
+         std::vector<std::unique_ptr<fc::thread>> _threads;
+         std::deque<fc::future<prefetched_block>> _pending;
+   };
+
+} // detail
+
 database::database()
 {
    initialize_indexes();
@@ -66,12 +141,16 @@ void database::reindex(fc::path data_dir, const genesis_state_type& initial_allo
    ilog( "Replaying blocks..." );
    _undo_db.disable();
    _undo_db.set_reindex_status(true);
+   std::unique_ptr<detail::block_prefetcher> prefetcher( new detail::block_prefetcher( data_dir / "database" / "block_num_to_block", last_block_num ) );
    for( uint32_t i = 1; i <= last_block_num; ++i )
    {
       if( i % 10000 == 0 ) std::cerr << "   " << double(i*100)/last_block_num << "%   "<<i << " of " <<last_block_num<<"   \n";
-      fc::optional< signed_block > block = _block_id_to_block.fetch_by_number(i);
+      detail::block_prefetcher::prefetched_block prefetched = prefetcher->next();
+      fc::optional< signed_block >& block = prefetched.block;
       if( !block.valid() )
       {
+         // stop the readers before blocks are dropped from the store
+         prefetcher.reset();
          wlog( "Reindexing terminated due to gap:  Block ${i} does not exist!", ("i", i) );
          uint32_t dropped_count = 0;
          while( true )
@@ -93,7 +172,9 @@ void database::reindex(fc::path data_dir, const genesis_state_type& initial_allo
          ilog("replay block: block num: ${block_num}, block: ${block}", 
             ("block_num", i)("block", *block));
       #endif
-      apply_block(*block, skip_witness_signature |
+      // the merkle root was already checked by the prefetcher, a mismatch is left for apply_block to report
+      apply_block(*block, (prefetched.merkle_ok ? skip_merkle_check : skip_nothing) |
+                          skip_witness_signature |
                           skip_transaction_signatures |
                           skip_transaction_dupe_check |
                           skip_tapos_check |
@@ -123,7 +204,7 @@ void database::open(
    {
       object_database::open(data_dir);
 
-      _block_id_to_block.open(data_dir / "database" / "block_num_to_block");
+      _block_id_to_block.open(data_dir / "database" / "block_num_to_block", _mmap_block_log);
 
       if( !find(global_property_id_type()) )
          init_genesis(genesis_loader());
@@ -190,6 +271,7 @@ void database::close(bool rewind)
       _block_id_to_block.close();
 
    _fork_db.reset();
+   _block_cache.clear();
 }
 
 void database::flush_block()
@@ -87,6 +87,7 @@ struct get_impacted_account_visitor
    void operator()( const asset_global_settle_operation& op ) {}
    void operator()( const asset_publish_feed_operation& op ) {}
    void operator()( const coin_feed_price_operation& op ) {}
+   void operator()( const coin_feed_price_batch_operation& op ) {}
    void operator()( const module_cfg_operation& op ) {}
    void operator()( const witness_create_operation& op )
    {
@@ -388,6 +389,8 @@ void get_relevant_accounts( const object* obj, flat_set<account_id_type>& accoun
               break;
              case impl_word_object_type:
               break;
+             case impl_coin_price_bucket_type:
+              break;
       }
    }
 } // end get_relevant_accounts( const object* obj, flat_set<account_id_type>& accounts )
@@ -402,11 +405,12 @@ bool need_to_notify(const object_id_type& object_id)
   bool needToNotify = (
     !(space == implementation_ids && type == impl_coin_dynamic_data_type) &&
     !(space == implementation_ids && type == impl_coin_price_data_type) && 
+    !(space == implementation_ids && type == impl_coin_price_bucket_type) && 
     !(space == protocol_ids && type == token_buy_object_type)
     );
   if (!needToNotify)
   {
-    ilog("no need to notify: ${object_id}", ("object_id", object_id));
+    tlog("no need to notify: ${object_id}", ("object_id", object_id));
   }
   return needToNotify;
 }
@@ -416,9 +420,34 @@ void database::notify_changed_objects()
    if( _undo_db.enabled() ) 
    {
       const auto& head_undo = _undo_db.head();
+      const bool per_object = !object_changes.empty();
+      vector<object_change> changes;
+      if( per_object )
+        changes.reserve( head_undo.new_ids.size() + head_undo.old_values.size() + head_undo.removed.size() );
+
+      // accounts are computed once per object and shared by the batch signals and object_changes
+      auto collect = [&]( object_change::change_kind kind, object_id_type id, const object* accounts_of,
+                          const object* obj, flat_set<account_id_type>& batch ) {
+        if( !per_object )
+        {
+          if( accounts_of != nullptr )
+            get_relevant_accounts( accounts_of, batch );
+          return;
+        }
+        changes.emplace_back();
+        object_change& change = changes.back();
+        change.kind = kind;
+        change.id   = id;
+        change.obj  = obj;
+        if( accounts_of != nullptr )
+        {
+          get_relevant_accounts( accounts_of, change.accounts );
+          batch.insert( change.accounts.begin(), change.accounts.end() );
+        }
+      };
 
       // New
-      if( !new_objects.empty() )
+      if( !new_objects.empty() || per_object )
       {
         vector<object_id_type> new_ids;  new_ids.reserve(head_undo.new_ids.size());
         flat_set<account_id_type> new_accounts_impacted;
@@ -426,17 +455,17 @@ void database::notify_changed_objects()
         {
           new_ids.push_back(item);
           auto obj = find_object(item);
-          if(obj != nullptr)
-            get_relevant_accounts(obj, new_accounts_impacted);
+          collect( object_change::created, item, obj, obj, new_accounts_impacted );
         }
-        ilog("new_accounts_impacted: ${new_accounts_impacted}, new_ids: ${new_ids}", 
+        tlog("new_accounts_impacted: ${new_accounts_impacted}, new_ids: ${new_ids}", 
           ("new_accounts_impacted", new_accounts_impacted)("new_ids", new_ids));
 
-        new_objects(new_ids, new_accounts_impacted);
+        if( !new_objects.empty() )
+          new_objects(new_ids, new_accounts_impacted);
       }
 
       // Changed
-      if( !changed_objects.empty() )
+      if( !changed_objects.empty() || per_object )
       {
         vector<object_id_type> changed_ids;  changed_ids.reserve(head_undo.old_values.size());
         flat_set<account_id_type> changed_accounts_impacted;
@@ -446,17 +475,19 @@ void database::notify_changed_objects()
           if (need_to_notify(item.first))
           {
             changed_ids.push_back(item.first);
-            get_relevant_accounts(item.second.get(), changed_accounts_impacted);
+            collect( object_change::modified, item.first, item.second.get(),
+                     per_object ? find_object(item.first) : nullptr, changed_accounts_impacted );
           }
         }
 
-        ilog("changed_accounts_impacted: ${changed_accounts_impacted}, changed_ids: ${changed_ids}", 
+        tlog("changed_accounts_impacted: ${changed_accounts_impacted}, changed_ids: ${changed_ids}", 
           ("changed_accounts_impacted", changed_accounts_impacted)("changed_ids", changed_ids));
-        changed_objects(changed_ids, changed_accounts_impacted);
+        if( !changed_objects.empty() )
+          changed_objects(changed_ids, changed_accounts_impacted);
       }
 
       // Removed
-      if( !removed_objects.empty() )
+      if( !removed_objects.empty() || per_object )
       {
         vector<object_id_type> removed_ids; removed_ids.reserve( head_undo.removed.size() );
         vector<const object*> removed; removed.reserve( head_undo.removed.size() );
@@ -466,13 +497,17 @@ void database::notify_changed_objects()
           removed_ids.emplace_back( item.first );
           auto obj = item.second.get();
           removed.emplace_back( obj );
-          get_relevant_accounts(obj, removed_accounts_impacted);
+          collect( object_change::removed, item.first, obj, obj, removed_accounts_impacted );
         }
-        ilog("removed_accounts_impacted: ${removed_accounts_impacted}, removed_ids: ${removed_ids}", 
+        tlog("removed_accounts_impacted: ${removed_accounts_impacted}, removed_ids: ${removed_ids}", 
           ("removed_accounts_impacted", removed_accounts_impacted)("removed_ids", removed_ids));
 
-        removed_objects(removed_ids, removed, removed_accounts_impacted);
+        if( !removed_objects.empty() )
+          removed_objects(removed_ids, removed, removed_accounts_impacted);
       }
+
+      if( per_object )
+        object_changes( changes );
    }
 } FC_CAPTURE_AND_LOG( (0) ) }
 
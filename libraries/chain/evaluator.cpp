@@ -44,9 +44,19 @@ database& generic_evaluator::db()const { return trx_state->db(); }
    { try {
       trx_state   = &eval_state;
       //check_required_authorities(op);
-      auto result = evaluate( op );
+      operation_stats* op_stats = db().block_operation_stats( op.which() );
 
-      if( apply ) result = this->apply( op );
+      operation_result result;
+      {
+         scoped_latency timer( op_stats ? &op_stats->evaluate : nullptr );
+         result = evaluate( op );
+      }
+
+      if( apply )
+      {
+         scoped_latency timer( op_stats ? &op_stats->apply : nullptr );
+         result = this->apply( op );
+      }
       return result;
    } FC_CAPTURE_AND_RETHROW() }
 
@@ -24,8 +24,112 @@
 #include <graphene/chain/global.hpp>
 #include <graphene/chain/word_object.hpp>
 
+#include <deque>
+
 namespace graphene { namespace chain {
 
+const size_t sensitive_word_matcher::npos;
+
+void sensitive_word_matcher::compile( const vector<string>& words )
+{
+    _nodes.clear();
+    _nodes.emplace_back();
+
+    // 构造字典树
+    for( size_t i = 0; i < words.size(); ++i )
+    {
+        uint32_t state = 0;
+        for( unsigned char c : words[i] )
+        {
+            auto itr = _nodes[state].next.find(c);
+            if( itr == _nodes[state].next.end() )
+            {
+                _nodes[state].next[c] = _nodes.size();
+                state = _nodes.size();
+                _nodes.emplace_back();
+            }
+            else
+                state = itr->second;
+        }
+        _nodes[state].first_word = std::min( _nodes[state].first_word, i );
+    }
+
+    // 按层次计算失败指针, 父节点总是先于子节点处理
+    std::deque<uint32_t> queue;
+    for( const auto& child : _nodes[0].next )
+    {
+        _nodes[child.second].first_word = std::min( _nodes[child.second].first_word, _nodes[0].first_word );
+        queue.push_back( child.second );
+    }
+    while( !queue.empty() )
+    {
+        uint32_t state = queue.front();
+        queue.pop_front();
+        for( const auto& child : _nodes[state].next )
+        {
+            uint32_t fail = _nodes[state].fail;
+            while( fail != 0 && _nodes[fail].next.find(child.first) == _nodes[fail].next.end() )
+                fail = _nodes[fail].fail;
+            auto itr = _nodes[fail].next.find(child.first);
+            if( itr != _nodes[fail].next.end() )
+                fail = itr->second;
+
+            node& n = _nodes[child.second];
+            n.fail = fail;
+            n.first_word = std::min( n.first_word, _nodes[fail].first_word );
+            queue.push_back( child.second );
+        }
+    }
+}
+
+size_t sensitive_word_matcher::find( const char* begin, const char* end )const
+{
+    if( _nodes.empty() )
+        return npos;
+
+    // 与 string::find 一致, 空敏感词匹配任何词
+    size_t result = _nodes[0].first_word;
+    uint32_t state = 0;
+    for( const char* p = begin; p != end && result != 0; ++p )
+    {
+        unsigned char c = *p;
+        auto itr = _nodes[state].next.find(c);
+        while( state != 0 && itr == _nodes[state].next.end() )
+        {
+            state = _nodes[state].fail;
+            itr = _nodes[state].next.find(c);
+        }
+        if( itr != _nodes[state].next.end() )
+            state = itr->second;
+        result = std::min( result, _nodes[state].first_word );
+    }
+    return result;
+}
+
+void sensitive_word_index::object_inserted( const object& obj )
+{
+    if( !source.valid() || obj.id < *source )
+    {
+        source = obj.id;
+        matcher.compile( static_cast<const word_object&>(obj).sensitive_words );
+    }
+}
+
+void sensitive_word_index::object_removed( const object& obj )
+{
+    if( source.valid() && obj.id == *source )
+    {
+        source.reset();
+        matcher.compile( vector<string>() );
+    }
+}
+
+void sensitive_word_index::object_modified( const object& after )
+{
+    if( source.valid() && after.id == *source )
+        matcher.compile( static_cast<const word_object&>(after).sensitive_words );
+}
+
 
 //判断一个词是否包含敏感词, 敏感词库不使用大写字母
 string word_contain_sensitive_word(string& word, graphene::chain::database& d)
@@ -34,6 +138,15 @@ string word_contain_sensitive_word(string& word, graphene::chain::database& d)
     auto itr = idx.begin();
     if (itr != idx.end())
     {
+        const auto& sidx = dynamic_cast<const primary_index<word_index>&>(d.get_index_type<word_index>())
+                              .get_secondary_index<sensitive_word_index>();
+        if (sidx.source.valid() && *sidx.source == itr->id)
+        {
+            size_t i = sidx.matcher.find(word.data(), word.data() + word.size());
+            return i == sensitive_word_matcher::npos ? "" : itr->sensitive_words[i];
+        }
+
+        // 自动机还未编译(如撤销删除操作后)，逐个查找
         for(auto itr2 = itr->sensitive_words.begin(); itr2 != itr->sensitive_words.end(); ++itr2)
         {
             if ( word.find(*itr2) != string::npos )
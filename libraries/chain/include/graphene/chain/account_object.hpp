@@ -25,6 +25,7 @@
 #include <graphene/chain/protocol/operations.hpp>
 #include <graphene/db/generic_index.hpp>
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/ranked_index.hpp>
 
 namespace graphene { namespace chain {
    class database;
@@ -350,6 +351,56 @@ namespace graphene { namespace chain {
     */
    typedef generic_index<account_balance_object, account_balance_object_multi_index_type> account_balance_index;
 
+   /**
+    *  @brief This secondary index keeps the holders of each asset, i.e. balances that are not zero, ranked by
+    *  balance so that counting them is O(1) and a page of holders at any offset is O(log n + page).
+    */
+   class asset_holder_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override;
+         virtual void object_removed( const object& obj ) override;
+         virtual void about_to_modify( const object& before ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         struct holder
+         {
+            asset_id_type   asset_type;
+            share_type      balance;
+            account_id_type owner;
+         };
+
+         uint32_t holder_count( asset_id_type asset )const;
+         /** the holders of asset with the largest balances first, skipping the first start of them */
+         vector<holder> get_holders( asset_id_type asset, uint32_t start, uint32_t limit )const;
+
+      private:
+         void add( const account_balance_object& b );
+         void remove( const account_balance_object& b );
+
+         typedef multi_index_container<
+            holder,
+            indexed_by<
+               ranked_unique<
+                  composite_key<
+                     holder,
+                     member<holder, asset_id_type, &holder::asset_type>,
+                     member<holder, share_type, &holder::balance>,
+                     member<holder, account_id_type, &holder::owner>
+                  >,
+                  composite_key_compare<
+                     std::less< asset_id_type >,
+                     std::greater< share_type >,
+                     std::less< account_id_type >
+                  >
+               >
+            >
+         > holder_multi_index_type;
+
+         holder_multi_index_type          _holders;
+         map< asset_id_type, uint32_t >   _counts;
+   };
+
    struct by_name{};
 
    /**
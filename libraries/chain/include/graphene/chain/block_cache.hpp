@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2017 AssetFun, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+#include <graphene/chain/config.hpp>
+#include <graphene/chain/protocol/block.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include <mutex>
+
+namespace graphene { namespace chain {
+   using boost::multi_index_container;
+   using namespace boost::multi_index;
+
+   struct cached_block
+   {
+      uint32_t                              num;
+      block_id_type                         id;
+      signed_block_header                   header;
+      std::shared_ptr<const vector<char>>   packed;
+   };
+   typedef std::shared_ptr<const vector<char>> packed_block_ptr;
+
+   /**
+    *  Bounded LRU of serialized blocks on the current chain near the head, so that serving a
+    *  recent block to a peer or an API client does not read block_database and pack it again.
+    *
+    *  Only blocks that became the head are inserted, and popped blocks are erased, so an entry
+    *  found by number is always on the current chain.  May be read from other threads.
+    */
+   class block_cache
+   {
+      public:
+         void set_capacity( size_t capacity )
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            _capacity = capacity;
+            shrink();
+         }
+
+         void insert( const signed_block& b )
+         {
+            if( _capacity == 0 )
+               return;
+            cached_block entry;
+            entry.num    = b.block_num();
+            entry.id     = b.id();
+            entry.header = b;
+            entry.packed = std::make_shared<const vector<char>>( fc::raw::pack( b ) );
+
+            std::lock_guard<std::mutex> guard( _lock );
+            auto& by_num = _blocks.get<block_num>();
+            by_num.erase( entry.num );
+            _blocks.push_front( std::move( entry ) );
+            shrink();
+         }
+
+         void remove( const block_id_type& id )
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            _blocks.get<block_id>().erase( id );
+         }
+
+         void clear()
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            _blocks.clear();
+         }
+
+         packed_block_ptr fetch_by_id( const block_id_type& id )
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            auto& by_id = _blocks.get<block_id>();
+            auto itr = by_id.find( id );
+            if( itr == by_id.end() )
+               return packed_block_ptr();
+            touch( _blocks.project<0>( itr ) );
+            return itr->packed;
+         }
+
+         packed_block_ptr fetch_by_number( uint32_t num )
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            auto& by_num = _blocks.get<block_num>();
+            auto itr = by_num.find( num );
+            if( itr == by_num.end() )
+               return packed_block_ptr();
+            touch( _blocks.project<0>( itr ) );
+            return itr->packed;
+         }
+
+         optional<signed_block_header> fetch_header_by_number( uint32_t num )
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            auto& by_num = _blocks.get<block_num>();
+            auto itr = by_num.find( num );
+            if( itr == by_num.end() )
+               return optional<signed_block_header>();
+            touch( _blocks.project<0>( itr ) );
+            return itr->header;
+         }
+
+         size_t size()const
+         {
+            std::lock_guard<std::mutex> guard( _lock );
+            return _blocks.size();
+         }
+
+      private:
+         struct block_id;
+         struct block_num;
+         typedef multi_index_container<
+            cached_block,
+            indexed_by<
+               sequenced<>,
+               hashed_unique< tag<block_id>, member< cached_block, block_id_type, &cached_block::id >, std::hash<fc::ripemd160> >,
+               ordered_unique< tag<block_num>, member< cached_block, uint32_t, &cached_block::num > >
+            >
+         > cache_type;
+
+         template<typename Iterator>
+         void touch( Iterator itr ) { _blocks.relocate( _blocks.begin(), itr ); }
+
+         void shrink()
+         {
+            while( _blocks.size() > _capacity )
+               _blocks.pop_back();
+         }
+
+         mutable std::mutex _lock;
+         size_t         _capacity = GRAPHENE_DEFAULT_BLOCK_CACHE_SIZE;
+         cache_type     _blocks;
+   };
+
+} } // graphene::chain
@@ -23,13 +23,28 @@
  */
 #pragma once
 #include <fstream>
+#include <memory>
 #include <graphene/chain/protocol/block.hpp>
+#include <fc/interprocess/file_mapping.hpp>
+
+namespace fc { class thread; }
 
 namespace graphene { namespace chain {
+   struct index_entry;
+
+   /**
+    * Like the streams it reads, a block_database is not thread safe: it must be opened, used and closed by one
+    * thread, which debug builds assert.  Readers on other threads open their own handle on the same files.
+    */
    class block_database 
    {
       public:
-         void open( const fc::path& dbdir );
+         /**
+          * @param use_mmap serve lookups from read-only mappings of the index and blocks files instead of
+          * seeking the streams.  Writes still go through the streams, and what was written since the files were
+          * last mapped is read through them too; store() maps the files again once that tail grows past 64 MiB.
+          */
+         void open( const fc::path& dbdir, bool use_mmap = false );
          bool is_open()const;
          void flush();
          void close();
@@ -44,7 +59,27 @@ namespace graphene { namespace chain {
          optional<signed_block> last()const;
          optional<block_id_type> last_id()const;
       private:
+         void         map_files();
+         template<typename Fill>
+         void         write_index_entry( uint64_t index_pos, Fill&& fill );
+         uint64_t     index_size()const;
+         void         read_index_entry( uint64_t index_pos, index_entry& e )const;
+         signed_block read_block( const index_entry& e )const;
+
          mutable std::fstream _blocks;
          mutable std::fstream _block_num_to_pos;
+
+         const fc::thread*                   _owner = nullptr;
+         bool                                _use_mmap = false;
+         fc::path                            _blocks_path;
+         fc::path                            _index_path;
+         uint64_t                            _index_bytes = 0;
+         /// bytes of each file covered by its mapping, 0 without one
+         uint64_t                            _blocks_mapped = 0;
+         uint64_t                            _index_mapped = 0;
+         std::unique_ptr<fc::file_mapping>   _blocks_mapping;
+         std::unique_ptr<fc::mapped_region>  _blocks_region;
+         std::unique_ptr<fc::file_mapping>   _index_mapping;
+         std::unique_ptr<fc::mapped_region>  _index_region;
    };
 } }
@@ -52,5 +52,20 @@ namespace graphene { namespace chain {
 
    };
 
+   class coin_object;
+
+   class coin_feed_price_batch_evaluator : public evaluator<coin_feed_price_batch_evaluator>
+   {
+      public:
+         typedef coin_feed_price_batch_operation operation_type;
+
+         void_result do_evaluate( const operation_type& o );
+         void_result do_apply( const operation_type& o );
+
+      private:
+         /// the coin of every entry of o.feeds, found by do_evaluate()
+         vector<const coin_object*> _coins;
+   };
+
 
 } } // graphene::chain
@@ -106,13 +106,39 @@ namespace graphene { namespace chain {
         //比如按天组织，则一天对应一个coin_price_data_object
         map<uint32_t, coin_price_data_id_type> prices;
         //最新的喂价时间(这里价格-1也视为‘有效’价格)
-        uint32_t latest_feed_time;
+        uint32_t latest_feed_time = 0;
         //最新的有效喂价和时间（不含-1）
         coin_price latest_valid_price;
         uint32_t latest_valid_time = 0;
         uint32_t invalid_price_count = 0;
     };
 
+    //已确认价格的压缩存储: 每个桶一小时, 每分钟一个价格
+    static const uint32_t COIN_PRICE_BUCKET_INTERVAL = 60*60;
+    static const uint32_t COIN_PRICE_BUCKET_SLOTS    = COIN_PRICE_BUCKET_INTERVAL / 60;
+
+    /**
+    *  @brief confirmed per-minute prices of one coin for one hour
+    *  @ingroup object
+    *  @ingroup implementation
+    *
+    *  Prices move here from coin_price_data_object and coin_fixed_data_object once they can no longer change,
+    *  without the per-publisher detail.  A slot without a confirmed price holds INVALID_FEED_PRICE.
+    */
+    class coin_price_bucket_object : public abstract_object<coin_price_bucket_object>
+    {
+    public:
+        static const uint8_t space_id = implementation_ids;
+        static const uint8_t type_id  = impl_coin_price_bucket_type;
+
+        coin_id_type        coin;
+        uint32_t            start = 0; // aligned to COIN_PRICE_BUCKET_INTERVAL
+        vector<share_type>  prices = vector<share_type>( COIN_PRICE_BUCKET_SLOTS, INVALID_FEED_PRICE );
+
+        static uint32_t bucket_start( uint32_t time ) { return time - time % COIN_PRICE_BUCKET_INTERVAL; }
+        static uint32_t bucket_slot( uint32_t time )  { return (time % COIN_PRICE_BUCKET_INTERVAL) / 60; }
+    };
+
     class coin_fixed_data_object : public abstract_object<coin_fixed_data_object>
     {
     public:
@@ -200,6 +226,21 @@ namespace graphene { namespace chain {
     > coin_fixed_data_object_multi_index_type;
     typedef generic_index<coin_fixed_data_object, coin_fixed_data_object_multi_index_type> coin_fixed_data_index;
 
+    struct by_coin_time;
+    typedef multi_index_container<
+        coin_price_bucket_object,
+        indexed_by<
+            ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
+            ordered_unique< tag<by_coin_time>,
+                composite_key< coin_price_bucket_object,
+                    member<coin_price_bucket_object, coin_id_type, &coin_price_bucket_object::coin>,
+                    member<coin_price_bucket_object, uint32_t, &coin_price_bucket_object::start>
+                >
+            >
+        >
+    > coin_price_bucket_object_multi_index_type;
+    typedef generic_index<coin_price_bucket_object, coin_price_bucket_object_multi_index_type> coin_price_bucket_index;
+
     struct by_platform_quote_base;
     typedef multi_index_container<
         coin_object,
@@ -231,6 +272,9 @@ FC_REFLECT_DERIVED( graphene::chain::coin_dynamic_data_object, (graphene::db::ob
 FC_REFLECT_DERIVED( graphene::chain::coin_fixed_data_object, (graphene::db::object),
 					(price_fixed) )
 
+FC_REFLECT_DERIVED( graphene::chain::coin_price_bucket_object, (graphene::db::object),
+                    (coin)(start)(prices) )
+
 
 FC_REFLECT_DERIVED( graphene::chain::coin_object, (graphene::db::object),
                     (platform_quote_base)
@@ -52,6 +52,8 @@
 
 #define GRAPHENE_MIN_UNDO_HISTORY 10
 #define GRAPHENE_MAX_UNDO_HISTORY 10000
+#define GRAPHENE_PARALLEL_VOTE_TALLY_MIN_ACCOUNTS 4096 ///< below this the maintenance vote tally stays on the calling thread
+#define GRAPHENE_DEFAULT_BLOCK_CACHE_SIZE 2048 ///< number of recent serialized blocks kept in memory for peers and API clients
 
 #define GRAPHENE_MIN_BLOCK_SIZE_LIMIT (GRAPHENE_MIN_TRANSACTION_SIZE_LIMIT*5) // 5 transactions per block
 #define GRAPHENE_MIN_TRANSACTION_EXPIRATION_LIMIT (GRAPHENE_MAX_BLOCK_INTERVAL * 5) // 5 transactions per block
@@ -144,7 +146,7 @@
 #define GRAPHENE_RECENTLY_MISSED_COUNT_INCREMENT             4
 #define GRAPHENE_RECENTLY_MISSED_COUNT_DECREMENT             3
 
-#define GRAPHENE_CURRENT_DB_VERSION                          "AFT1.0"
+#define GRAPHENE_CURRENT_DB_VERSION                          "AFT1.1"
 
 #define GRAPHENE_IRREVERSIBLE_THRESHOLD                      (70 * GRAPHENE_1_PERCENT)
 
@@ -28,6 +28,8 @@
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/chain/fork_database.hpp>
 #include <graphene/chain/block_database.hpp>
+#include <graphene/chain/block_cache.hpp>
+#include <graphene/chain/performance_stats.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/chain/evaluator.hpp>
 
@@ -35,6 +37,8 @@
 #include <graphene/db/object.hpp>
 #include <graphene/db/simple_index.hpp>
 #include <fc/signals.hpp>
+#include <fc/thread/thread.hpp>
+#include <fc/thread/thread_specific.hpp>
 
 #include <graphene/chain/protocol/protocol.hpp>
 
@@ -44,6 +48,9 @@
 
 #include <fc/log/logger.hpp>
 
+#include <boost/thread/shared_mutex.hpp>
+
+#include <atomic>
 #include <map>
 
 namespace graphene { namespace chain {
@@ -54,6 +61,18 @@ namespace graphene { namespace chain {
 
    struct budget_record;
 
+   /// One object created, modified or removed by a block, see database::object_changes
+   struct object_change
+   {
+      enum change_kind { created, modified, removed };
+
+      change_kind               kind;
+      object_id_type            id;
+      /// current value, or the last value of a removed object; only valid during the signal
+      const object*             obj = nullptr;
+      flat_set<account_id_type> accounts;
+   };
+
    /**
     *   @class database
     *   @brief tracks the blockchain state in an extensible manner
@@ -127,6 +146,10 @@ namespace graphene { namespace chain {
          block_id_type              get_block_id_for_num( uint32_t block_num )const;
          optional<signed_block>     fetch_block_by_id( const block_id_type& id )const;
          optional<signed_block>     fetch_block_by_number( uint32_t num )const;
+         /// Serialized block from the recent block cache, null if it is not cached
+         packed_block_ptr           fetch_packed_block_by_id( const block_id_type& id )const;
+         packed_block_ptr           fetch_packed_block_by_number( uint32_t num )const;
+         optional<signed_block_header> fetch_block_header_by_number( uint32_t num )const;
          const signed_transaction&  get_recent_transaction( const transaction_id_type& trx_id )const;
          std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
@@ -140,7 +163,57 @@ namespace graphene { namespace chain {
          const flat_map<uint32_t,block_id_type> get_checkpoints()const { return _checkpoints; }
          bool before_last_checkpoint()const;
 
+         /// Serve block log reads from memory-mapped files, takes effect on the next open()
+         void set_mmap_block_log( bool enable ) { _mmap_block_log = enable; }
+         /// Number of recent serialized blocks kept for fetch_packed_block_by_*(), 0 disables the cache
+         void set_block_cache_size( size_t size ) { _block_cache.set_capacity( size ); }
+
+         /// Evaluator latencies per operation type and block apply time per phase
+         const performance_stats& get_performance_stats()const { return _performance_stats; }
+         performance_stats&       get_performance_stats() { return _performance_stats; }
+         void                     reset_performance_stats();
+         /// Log a summary of get_performance_stats() every n blocks, 0 disables it
+         void                     set_performance_dump_interval( uint32_t n ) { _performance_dump_interval = n; }
+         void                     dump_performance_stats()const;
+         /// Stats to record an operation with tag which into, null unless stats are enabled and a block is being applied
+         operation_stats*         block_operation_stats( int which );
+
+         /// Number of threads with_read_access() runs its calls on, 0 runs them on the calling thread
+         void set_read_worker_threads( uint32_t count );
+
+         /**
+          *  Run f on one of the read worker threads and return its result.  f sees the state between two
+          *  writes: push_block(), push_transaction(), generate_block(), pop_block() and clear_pending()
+          *  hold back new readers, and wait for the ones already running without blocking the calling
+          *  thread, so a write is delayed by at most one query per worker.
+          *
+          *  Nothing yields while a write is in progress, so only the task making it can call this
+          *  meanwhile; its reads run inline.
+          *
+          *  f must only read the object database, block_database and fork_database are not thread safe.
+          */
+         template<typename F>
+         auto with_read_access( F&& f )const -> decltype( f() )
+         {
+            if( _write_depth > 0 )
+            {
+               FC_ASSERT( _write_owner.get() != nullptr, "state read by another task while a write is in progress" );
+               return f();
+            }
+            if( _read_threads.empty() )
+               return f();
+            auto& worker = _read_threads[ _next_read_thread++ % _read_threads.size() ];
+            return worker->async( [this, &f]() {
+               while( _writes_pending > 0 )
+                  fc::usleep( fc::microseconds( 100 ) );
+               boost::shared_lock<boost::shared_mutex> guard( _state_lock );
+               return f();
+            }, "with_read_access" ).wait();
+         }
+
          bool push_block( const signed_block& b, uint32_t skip = skip_nothing );
+         /// Recovers the signing keys of all transactions in b on worker threads so the serial apply hits the key cache
+         void precompute_signature_keys( const signed_block& b );
          processed_transaction push_transaction( const signed_transaction& trx, uint32_t skip = skip_nothing );
          bool _push_block( const signed_block& b );
          processed_transaction _push_transaction( const signed_transaction& trx );
@@ -211,6 +284,13 @@ namespace graphene { namespace chain {
           */
          fc::signal<void(const vector<object_id_type>&, const vector<const object*>&, const flat_set<account_id_type>&)>  removed_objects;
 
+         /**
+          *  Emitted after the three signals above with every object of the block and the accounts it is
+          *  relevant to, so listeners can dispatch per object instead of per batch.  Created objects come
+          *  first, then modified, then removed.  The callback should not yield.
+          */
+         fc::signal<void(const vector<object_change>&)> object_changes;
+
          //////////////////// db_witness_schedule.cpp ////////////////////
 
          /**
@@ -263,6 +343,21 @@ namespace graphene { namespace chain {
 
          coin_price get_coin_price(const string& platform_id, const string& quote_base, uint32_t time_second)const;
          std::pair<uint32_t, coin_price> get_latest_valid_price(const string& platform_id, const string& quote_base)const;
+         /// Confirmed price of coin at time from coin_price_bucket_index, if that minute has been compacted
+         optional<share_type> find_compacted_coin_price(coin_id_type coin, uint32_t time_second)const;
+         /**
+          * True if the day of time_second has been moved into coin_price_bucket_index by compact_coin_prices.  Feeds
+          * for such a minute are refused, so they cannot recreate a partial day object or undo a compacted price.
+          */
+         bool is_coin_price_compacted(const coin_object& coin, uint32_t time_second)const;
+         /// Throw if any minute of prices is compacted, shared by the single and the batch feed
+         void assert_coin_prices_not_compacted(const coin_object& coin, const map<uint32_t, share_type>& prices)const;
+         /**
+          * Move confirmed prices out of coin_fixed_data_object and out of coin_price_data_objects older than the
+          * current feeding day into coin_price_bucket_index, dropping the per-publisher detail.  Run at maintenance
+          * from HARDFORK_COIN_PRICE_BUCKET_TIME on.
+          */
+         void compact_coin_prices();
 
          module_cfg_object get_module_cfg(const string& module_name)const;
 
@@ -516,6 +611,52 @@ namespace graphene { namespace chain {
           *  the fork tree relatively simple.
           */
          block_database   _block_id_to_block;
+         bool             _mmap_block_log = false;
+         /// serialized blocks of the current chain near the head, filled by push_block()
+         mutable block_cache _block_cache;
+
+         performance_stats _performance_stats;
+         uint32_t          _performance_dump_interval = 0;
+         /// set by _apply_block(), pending transactions and block generation are not recorded in _performance_stats
+         bool              _applying_block = false;
+
+         /**
+          *  Held by the task that changes the chain state, see with_read_access().  Only the outermost
+          *  instance takes _state_lock, and only the task holding it may nest further instances.
+          */
+         class write_access
+         {
+            public:
+               explicit write_access( database& db ) : _db( db )
+               {
+                  if( _db._write_depth > 0 )
+                     FC_ASSERT( _db._write_owner.get() != nullptr, "state changed by another task while a write is in progress" );
+                  else
+                     _db.lock_state_for_write();
+                  ++_db._write_depth;
+               }
+               ~write_access()
+               {
+                  if( --_db._write_depth == 0 )
+                     _db.unlock_state_for_write();
+               }
+            private:
+               database& _db;
+         };
+
+         /// Takes _state_lock exclusively, yielding to other tasks rather than blocking while readers finish
+         void lock_state_for_write();
+         void unlock_state_for_write();
+
+         /// workers for with_read_access(), see set_read_worker_threads()
+         vector<std::shared_ptr<fc::thread>> _read_threads;
+         mutable uint32_t                    _next_read_thread = 0;
+         mutable boost::shared_mutex         _state_lock;
+         /// writers waiting for _state_lock, new readers wait until there are none
+         std::atomic<uint32_t>               _writes_pending{ 0 };
+         uint32_t                            _write_depth = 0;
+         /// set only in the task that holds write access
+         fc::task_specific_ptr<bool>         _write_owner;
 
          /**
           * Contains the set of ops that are in the process of being applied from
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 AssetFun, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+#include <graphene/chain/protocol/operations.hpp>
+
+#include <fc/time.hpp>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  Count and latency of something measured repeatedly.  buckets[i] counts the
+    *  durations shorter than 2^i microseconds, the last bucket takes everything longer.
+    */
+   struct latency_histogram
+   {
+      static const size_t bucket_count = 24;
+
+      uint64_t         count    = 0;
+      uint64_t         total_us = 0;
+      uint64_t         max_us   = 0;
+      vector<uint64_t> buckets  = vector<uint64_t>( bucket_count );
+
+      void record( int64_t us )
+      {
+         uint64_t d = us > 0 ? uint64_t(us) : 0;
+         ++count;
+         total_us += d;
+         max_us = std::max( max_us, d );
+         size_t b = 0;
+         while( b + 1 < bucket_count && (uint64_t(1) << b) <= d )
+            ++b;
+         ++buckets[b];
+      }
+   };
+
+   /// Time spent in the evaluator of one operation type
+   struct operation_stats
+   {
+      latency_histogram evaluate;
+      latency_histogram apply;
+      uint64_t          failed       = 0;
+      /// objects created, modified or removed, i.e. entries added to the undo state
+      uint64_t          undo_entries = 0;
+   };
+
+   /// Time spent applying blocks, in total and in the phases that can dominate it
+   struct block_apply_stats
+   {
+      latency_histogram total;
+      latency_histogram transactions;
+      latency_histogram maintenance;
+      latency_histogram expire_subject_event;
+      latency_histogram expire_token_event;
+      latency_histogram notify_changed_objects;
+   };
+
+   /**
+    *  Counters kept by database while applying operations and blocks, see database::get_performance_stats().
+    *  Updated on the thread that applies blocks.
+    */
+   struct performance_stats
+   {
+      bool                      enabled = true;
+      /// indexed by operation tag
+      vector<operation_stats>   operations = vector<operation_stats>( operation::count() );
+      block_apply_stats         blocks;
+
+      operation_stats& get_operation( int which )
+      {
+         if( size_t(which) >= operations.size() )
+            operations.resize( which + 1 );
+         return operations[which];
+      }
+   };
+
+   /// Records the time between construction and destruction into h, does nothing if h is null
+   class scoped_latency
+   {
+      public:
+         scoped_latency( latency_histogram* h ) : _h( h )
+         {
+            if( _h )
+               _start = fc::time_point::now();
+         }
+         ~scoped_latency()
+         {
+            if( _h )
+               _h->record( (fc::time_point::now() - _start).count() );
+         }
+
+      private:
+         latency_histogram* _h;
+         fc::time_point     _start;
+   };
+
+   namespace detail {
+      struct operation_name_visitor
+      {
+         typedef string result_type;
+         template<typename T>
+         string operator()( const T& )const
+         {
+            string name = fc::get_typename<T>::name();
+            auto pos = name.rfind( ':' );
+            return pos == string::npos ? name : name.substr( pos + 1 );
+         }
+      };
+   }
+
+   /// Name of the operation with tag which, e.g. "transfer_operation"
+   inline string operation_type_name( int which )
+   {
+      operation op;
+      op.set_which( which );
+      return op.visit( detail::operation_name_visitor() );
+   }
+
+} } // graphene::chain
+
+FC_REFLECT( graphene::chain::latency_histogram, (count)(total_us)(max_us)(buckets) )
+FC_REFLECT( graphene::chain::operation_stats, (evaluate)(apply)(failed)(undo_entries) )
+FC_REFLECT( graphene::chain::block_apply_stats,
+            (total)(transactions)(maintenance)(expire_subject_event)(expire_token_event)(notify_changed_objects) )
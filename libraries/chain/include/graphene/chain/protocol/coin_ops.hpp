@@ -140,7 +140,37 @@ namespace graphene { namespace chain {
       void            validate()const;
    };
 
+   /**
+    * @brief Publish prices of several coins at once
+    * @ingroup operations
+    *
+    * Same as one coin_feed_price_operation per entry of @ref feeds, but signed and paid for once.  Coins are named
+    * by id, their platform and quote base come from the coin_object.  @ref feeds must be sorted by coin_id without
+    * duplicates.
+    */
+   struct coin_feed_price_batch_operation : public base_operation
+   {
+      struct fee_parameters_type {
+         uint64_t fee            = 100;
+         uint32_t price_per_feed = 10; ///< for every entry of feeds
+      };
+
+      struct coin_feed
+      {
+         coin_id_type              coin_id;
+         map<uint32_t, share_type> prices; ///< <time in second, price>
+         bool                      reset_price = false;
+      };
 
+      asset             fee; ///< paid for by publisher
+      account_id_type   publisher;
+      vector<coin_feed> feeds;
+      extensions_type   extensions;
+
+      account_id_type fee_payer()const { return publisher; }
+      void            validate()const;
+      share_type      calculate_fee( const fee_parameters_type& k )const;
+   };
 
 } } // graphene::chain
 
@@ -150,6 +180,8 @@ namespace graphene { namespace chain {
 FC_REFLECT( graphene::chain::coin_update_feed_producers_operation::fee_parameters_type, (fee) )
 FC_REFLECT( graphene::chain::coin_feed_price_operation::fee_parameters_type, (fee) )
 FC_REFLECT( graphene::chain::coin_feed_price_operation::ext, (null_ext) )
+FC_REFLECT( graphene::chain::coin_feed_price_batch_operation::fee_parameters_type, (fee)(price_per_feed) )
+FC_REFLECT( graphene::chain::coin_feed_price_batch_operation::coin_feed, (coin_id)(prices)(reset_price) )
 
 FC_REFLECT( graphene::chain::coin_price,
             (price)(platform_quote_base)(src)
@@ -164,4 +196,5 @@ FC_REFLECT( graphene::chain::coin_update_feed_producers_operation,
           )
 FC_REFLECT( graphene::chain::coin_feed_price_operation,
             (fee)(publisher)(coin_id)(platform_id)(quote_base)(prices)(reset_price)(extensions) );
-
+FC_REFLECT( graphene::chain::coin_feed_price_batch_operation,
+            (fee)(publisher)(feeds)(extensions) )
@@ -25,6 +25,7 @@
 
 #include <fc/io/varint.hpp>
 #include <fc/reflect/reflect.hpp>
+#include <graphene/db/type_description.hpp>
 
 namespace graphene { namespace chain {
 
@@ -210,3 +211,14 @@ void to_variant( const graphene::chain::extension<T>& value, fc::variant& var )
 }
 
 } // fc
+
+namespace graphene { namespace db {
+
+/// An extension is packed as the present optional members of T, so its layout is that of T
+template< typename T >
+struct type_description< graphene::chain::extension<T> >
+{
+   static void append( std::string& desc, uint32_t depth ) { type_description<T>::append( desc, depth ); }
+};
+
+} } // graphene::db
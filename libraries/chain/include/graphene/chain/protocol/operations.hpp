@@ -105,7 +105,8 @@ namespace graphene { namespace chain {
             account_set_homepage_operation,// 50
             token_publish_operation,
             token_buy_operation,
-            token_event_operation
+            token_event_operation,
+            coin_feed_price_batch_operation
          > operation;
 
    /// @} // operations group
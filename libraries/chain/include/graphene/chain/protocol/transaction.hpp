@@ -173,6 +173,13 @@ namespace graphene { namespace chain {
       void clear() { operations.clear(); signatures.clear(); }
    };
 
+   /**
+    * Recovers the public key that produced sig over digest d.  Results are kept in a bounded process-wide cache
+    * shared by all threads, so a transaction verified in the mempool, in block production and again when the
+    * block is applied pays for ECDSA recovery only once.
+    */
+   public_key_type recover_signature_key( const digest_type& d, const signature_type& sig );
+
    void verify_authority( const vector<operation>& ops, const flat_set<public_key_type>& sigs,
                           const std::function<const authority*(account_id_type)>& get_active,
                           const std::function<const authority*(account_id_type)>& get_owner,
@@ -175,7 +175,8 @@ namespace graphene { namespace chain {
 	  impl_coin_fixed_data_type,    //19
       impl_coin_price_data_type,     //20
       impl_token_statistics_object_type, //21, 众筹认购明细统计
-      impl_word_object_type //22, 敏感词
+      impl_word_object_type, //22, 敏感词
+      impl_coin_price_bucket_type //23, 已确认价格按小时压缩存储
    };
 
    //typedef fc::unsigned_int            object_id_type;
@@ -247,6 +248,7 @@ namespace graphene { namespace chain {
    class coin_price_data_object;
    class token_statistics_object;
    class word_object;
+   class coin_price_bucket_object;
 
    typedef object_id< implementation_ids, impl_global_property_object_type,  global_property_object>                    global_property_id_type;
    typedef object_id< implementation_ids, impl_dynamic_global_property_object_type,  dynamic_global_property_object>    dynamic_global_property_id_type;
@@ -273,6 +275,7 @@ namespace graphene { namespace chain {
    typedef object_id< implementation_ids, impl_subject_statistics_object_type,subject_statistics_object>                subject_statistics_id_type;
    typedef object_id< implementation_ids, impl_token_statistics_object_type, token_statistics_object>                   token_statistics_id_type;
    typedef object_id< implementation_ids, impl_word_object_type, word_object>                                           word_id_type;
+   typedef object_id< implementation_ids, impl_coin_price_bucket_type, coin_price_bucket_object>                        coin_price_bucket_id_type;
 
    typedef fc::array<char, GRAPHENE_MAX_ASSET_SYMBOL_LENGTH>    symbol_type;
    typedef fc::ripemd160                                        block_id_type;
@@ -419,6 +422,7 @@ FC_REFLECT_ENUM( graphene::chain::impl_object_type,
                  (impl_coin_price_data_type)
                  (impl_token_statistics_object_type)
                  (impl_word_object_type)
+                 (impl_coin_price_bucket_type)
                )
 
 FC_REFLECT_TYPENAME( graphene::chain::share_type )
@@ -262,17 +262,31 @@ namespace graphene { namespace chain {
       indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
           ordered_non_unique< tag<by_subject_name>, member<subject_object, string, &subject_object::subject_name> >,
-          ordered_non_unique< tag<by_subject_status>, member<subject_object, object_status_type, &subject_object::status> >,
+          ordered_unique< tag<by_subject_status>,
+              composite_key< subject_object,
+                  member<subject_object, object_status_type, &subject_object::status>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
           ordered_non_unique< tag<by_creator>, member<subject_object, account_id_type, &subject_object::creator> >,
-          ordered_non_unique< tag<by_creator_time>,
-              const_mem_fun<subject_object, time_point_sec, &subject_object::subject_creator_time>
+          ordered_unique< tag<by_creator_time>,
+              composite_key< subject_object,
+                  const_mem_fun<subject_object, time_point_sec, &subject_object::subject_creator_time>,
+                  member<object, object_id_type, &object::id>
+              >
           >,
-          ordered_non_unique< tag<by_vote_end_time>,
-              const_mem_fun<subject_object, time_point_sec, &subject_object::vote_end_time>
+          ordered_unique< tag<by_vote_end_time>,
+              composite_key< subject_object,
+                  const_mem_fun<subject_object, time_point_sec, &subject_object::vote_end_time>,
+                  member<object, object_id_type, &object::id>
+              >
           >,
 		  //[lilianwen add 2017-10-31]
-		  ordered_non_unique< tag<by_prediction_end_time>,
-		  const_mem_fun<subject_object, time_point_sec, &subject_object::vote_judge_time>
+		  ordered_unique< tag<by_prediction_end_time>,
+		      composite_key< subject_object,
+		          const_mem_fun<subject_object, time_point_sec, &subject_object::vote_judge_time>,
+		          member<object, object_id_type, &object::id>
+		      >
 		  >
 		  //[end]
       >
@@ -282,13 +296,32 @@ namespace graphene { namespace chain {
 
    struct by_subject_id;
    struct by_voter;
+   struct by_voter_subject;
    struct by_vote_time;
    typedef multi_index_container<
       subject_vote_object,
       indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
-          ordered_non_unique< tag<by_subject_id>, member<subject_vote_object, subject_id_type, &subject_vote_object::subject_id> >,
-          ordered_non_unique< tag<by_voter>, member<subject_vote_object, account_id_type, &subject_vote_object::voter> >,
+          ordered_unique< tag<by_subject_id>,
+              composite_key< subject_vote_object,
+                  member<subject_vote_object, subject_id_type, &subject_vote_object::subject_id>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
+          ordered_unique< tag<by_voter>,
+              composite_key< subject_vote_object,
+                  member<subject_vote_object, account_id_type, &subject_vote_object::voter>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
+          /// votes of one account on one subject, in vote id order
+          ordered_unique< tag<by_voter_subject>,
+              composite_key< subject_vote_object,
+                  member<subject_vote_object, account_id_type, &subject_vote_object::voter>,
+                  member<subject_vote_object, subject_id_type, &subject_vote_object::subject_id>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
           ordered_non_unique< tag<by_vote_time>,
               const_mem_fun<subject_vote_object, time_point_sec, &subject_vote_object::subject_vote_time>
           >
@@ -307,9 +307,24 @@ namespace graphene { namespace chain {
           ordered_non_unique< tag<by_issuer>, member<token_object, account_id_type, &token_object::issuer> >,
           ordered_non_unique< tag<by_upper_case_asset_name>, const_mem_fun<token_object, string, &token_object::get_upper_case_asset_name> >,
           ordered_non_unique< tag<by_asset_symbol>, const_mem_fun<token_object, string, &token_object::get_asset_symbol> >,
-          ordered_non_unique< tag<by_create_time>, const_mem_fun<token_object, time_point_sec, &token_object::get_create_time> >,
-		  ordered_non_unique< tag<by_end_time>, const_mem_fun<token_object, time_point_sec, &token_object::phase2_end_time> >,
-		  ordered_non_unique< tag<by_guaranty_credit>, member<token_object, share_type, &token_object::guaranty_credit> >
+          ordered_unique< tag<by_create_time>,
+              composite_key< token_object,
+                  const_mem_fun<token_object, time_point_sec, &token_object::get_create_time>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
+		  ordered_unique< tag<by_end_time>,
+		      composite_key< token_object,
+		          const_mem_fun<token_object, time_point_sec, &token_object::phase2_end_time>,
+		          member<object, object_id_type, &object::id>
+		      >
+		  >,
+		  ordered_unique< tag<by_guaranty_credit>,
+		      composite_key< token_object,
+		          member<token_object, share_type, &token_object::guaranty_credit>,
+		          member<object, object_id_type, &object::id>
+		      >
+		  >
           //ordered_non_unique< tag<by_collected_core_asset>, const_mem_fun<token_object, share_type, &token_object::get_actual_core_asset_total> >,
         //>,
 		  >
@@ -328,13 +343,26 @@ namespace graphene { namespace chain {
 
    struct by_token_id;
    struct by_buyer;
+   struct by_buyer_token;
    struct by_buy_time;
    typedef multi_index_container<
       token_buy_object,
       indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
-          ordered_non_unique< tag<by_token_id>, member<token_buy_object, token_id_type, &token_buy_object::token_id> >,
+          ordered_unique< tag<by_token_id>,
+              composite_key< token_buy_object,
+                  member<token_buy_object, token_id_type, &token_buy_object::token_id>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
           ordered_non_unique< tag<by_buyer>, member<token_buy_object, account_id_type, &token_buy_object::buyer> >,
+          ordered_unique< tag<by_buyer_token>,
+              composite_key< token_buy_object,
+                  member<token_buy_object, account_id_type, &token_buy_object::buyer>,
+                  member<token_buy_object, token_id_type, &token_buy_object::token_id>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
           ordered_non_unique< tag<by_buy_time>,
               member<token_buy_object, time_point_sec, &token_buy_object::buy_time>
           >
@@ -362,8 +390,18 @@ namespace graphene { namespace chain {
       indexed_by<
           ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
           ordered_non_unique< tag<by_token_id>, member< token_statistics_object, token_id_type, &token_statistics_object::token_id > >,
-          ordered_non_unique< tag<by_buyer_number>, member<token_statistics_object, uint64_t, &token_statistics_object::buyer_number> >,
-          ordered_non_unique< tag<by_actual_core_asset_total>, member<token_statistics_object, share_type, &token_statistics_object::actual_core_asset_total> >
+          ordered_unique< tag<by_buyer_number>,
+              composite_key< token_statistics_object,
+                  member<token_statistics_object, uint64_t, &token_statistics_object::buyer_number>,
+                  member<object, object_id_type, &object::id>
+              >
+          >,
+          ordered_unique< tag<by_actual_core_asset_total>,
+              composite_key< token_statistics_object,
+                  member<token_statistics_object, share_type, &token_statistics_object::actual_core_asset_total>,
+                  member<object, object_id_type, &object::id>
+              >
+          >
       >
    > token_statistics_index_multi_index_type;
    typedef generic_index<token_statistics_object, token_statistics_index_multi_index_type> token_statistics_index;
@@ -24,6 +24,7 @@
 #pragma once
 #include <graphene/chain/protocol/operations.hpp>
 #include <graphene/db/object.hpp>
+#include <graphene/db/generic_index.hpp>
 #include <boost/multi_index/composite_key.hpp>
 
 namespace graphene { namespace chain {
@@ -68,6 +69,50 @@ typedef multi_index_container<
 
 typedef generic_index<word_object, word_object_multi_index_type> word_index;
 
+   /**
+    *  @brief Aho-Corasick automaton compiled from a list of sensitive words
+    *
+    *  Text is matched byte by byte, so UTF-8 words need no special handling. A single pass over the text finds the
+    *  lowest-indexed word it contains, which is the word the former per-word std::string::find loop reported.
+    */
+   class sensitive_word_matcher
+   {
+      public:
+         static const size_t npos = size_t(-1);
+
+         void compile( const vector<string>& words );
+
+         /// @return index into the compiled word list of the first word contained in [begin, end), or npos
+         size_t find( const char* begin, const char* end )const;
+
+      private:
+         struct node
+         {
+            flat_map<unsigned char, uint32_t> next;
+            uint32_t                          fail = 0;
+            /** lowest index of a word ending here or at any state on the fail chain */
+            size_t                            first_word = npos;
+         };
+
+         vector<node> _nodes;
+   };
+
+   /**
+    *  @brief This secondary index keeps the sensitive word automaton of the word_object with the lowest id,
+    *  recompiling it whenever the word_configurator updates that object.
+    */
+   class sensitive_word_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override;
+         virtual void object_removed( const object& obj ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         /** the word_object the matcher was compiled from, invalid if it has to be rebuilt */
+         optional<object_id_type>  source;
+         sensitive_word_matcher    matcher;
+   };
+
    
 } } // graphene::chain
 
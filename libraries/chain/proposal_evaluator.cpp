@@ -26,11 +26,39 @@
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/protocol/fee_schedule.hpp>
 #include <graphene/chain/exceptions.hpp>
+#include <graphene/chain/hardfork.hpp>
 
 #include <fc/smart_ref_impl.hpp>
 
 namespace graphene { namespace chain {
 
+namespace detail {
+
+   /// Rejects proposed operations that are not allowed yet at block_time, including in nested proposals
+   struct proposal_operation_hardfork_visitor
+   {
+      typedef void result_type;
+      const fc::time_point_sec block_time;
+
+      proposal_operation_hardfork_visitor( const fc::time_point_sec bt ) : block_time( bt ) {}
+
+      template<typename T>
+      void operator()( const T& v )const {}
+
+      void operator()( const coin_feed_price_batch_operation& v )const
+      {
+         FC_ASSERT( block_time >= HARDFORK_COIN_FEED_BATCH_TIME, "coin_feed_price_batch_operation is not allowed yet" );
+      }
+
+      void operator()( const proposal_create_operation& v )const
+      {
+         for( const op_wrapper& op : v.proposed_ops )
+            op.op.visit( *this );
+      }
+   };
+
+} // namespace detail
+
 void_result proposal_create_evaluator::do_evaluate(const proposal_create_operation& o)
 { try {
    const database& d = db();
@@ -42,6 +70,9 @@ void_result proposal_create_evaluator::do_evaluate(const proposal_create_operati
    FC_ASSERT( !o.review_period_seconds || fc::seconds(*o.review_period_seconds) < (o.expiration_time - d.head_block_time()),
               "Proposal review period must be less than its overall lifetime." );
 
+   detail::proposal_operation_hardfork_visitor vtor( d.head_block_time() );
+   vtor( o );
+
    {
       // If we're dealing with the committee authority, make sure this transaction has a sufficient review period.
       flat_set<account_id_type> auths;
@@ -37,6 +37,26 @@ void coin_feed_price_operation::validate()const
 }
 
 
+void coin_feed_price_batch_operation::validate()const
+{
+   FC_ASSERT( fee.amount >= 0, "zero fee" );
+   FC_ASSERT( !feeds.empty(), "empty feeds" );
+   for( size_t i = 0; i < feeds.size(); ++i )
+   {
+      FC_ASSERT( i == 0 || feeds[i-1].coin_id < feeds[i].coin_id, "feeds not sorted by coin_id or duplicated" );
+      FC_ASSERT( !feeds[i].prices.empty(), "empty prices" );
+      for( const auto& price : feeds[i].prices )
+      {
+         FC_ASSERT( price.first % 60 == 0, "time not aligned to 60" );
+         FC_ASSERT( price.second > 0 || price.second == INVALID_FEED_PRICE, "invalid price ${p}", ("p", price.second) );
+      }
+   }
+}
+
+share_type coin_feed_price_batch_operation::calculate_fee( const fee_parameters_type& k )const
+{
+   return k.fee + share_type( k.price_per_feed ) * feeds.size();
+}
 
 void coin_update_feed_producers_operation::validate() const
 {
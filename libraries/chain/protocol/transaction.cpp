@@ -27,9 +27,72 @@
 #include <fc/bitutil.hpp>
 #include <fc/smart_ref_impl.hpp>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 
 namespace graphene { namespace chain {
 
+namespace detail {
+
+   /// FIFO-bounded map from hash(digest, signature) to the recovered key
+   class signature_key_cache
+   {
+      public:
+         static const size_t max_size = 1 << 16;
+
+         bool find( const digest_type& key, public_key_type& result )
+         {
+            std::lock_guard<std::mutex> lock( _mutex );
+            auto itr = _keys.find( key );
+            if( itr == _keys.end() )
+               return false;
+            result = itr->second;
+            return true;
+         }
+
+         void insert( const digest_type& key, const public_key_type& pub )
+         {
+            std::lock_guard<std::mutex> lock( _mutex );
+            if( !_keys.emplace( key, pub ).second )
+               return;
+            _order.push_back( key );
+            if( _order.size() > max_size )
+            {
+               _keys.erase( _order.front() );
+               _order.pop_front();
+            }
+         }
+
+      private:
+         std::mutex                                         _mutex;
+         std::unordered_map<digest_type, public_key_type>   _keys;
+         std::deque<digest_type>                            _order;
+   };
+
+   static signature_key_cache& get_signature_key_cache()
+   {
+      static signature_key_cache cache;
+      return cache;
+   }
+
+}
+
+public_key_type recover_signature_key( const digest_type& d, const signature_type& sig )
+{
+   digest_type::encoder enc;
+   enc.write( d.data(), sizeof(d) );
+   enc.write( (const char*)sig.begin(), sig.size() );
+   digest_type key = enc.result();
+
+   public_key_type result;
+   if( detail::get_signature_key_cache().find( key, result ) )
+      return result;
+   result = fc::ecc::public_key( sig, d );
+   detail::get_signature_key_cache().insert( key, result );
+   return result;
+}
+
 digest_type processed_transaction::merkle_digest()const
 {
    digest_type::encoder enc;
@@ -352,7 +415,7 @@ flat_set<public_key_type> signed_transaction::get_signature_keys( const chain_id
    for( const auto&  sig : signatures )
    {
       GRAPHENE_ASSERT(
-         result.insert( fc::ecc::public_key(sig,d) ).second,
+         result.insert( recover_signature_key( d, sig ) ).second,
          tx_duplicate_sig,
          "Duplicate Signature detected" );
    }
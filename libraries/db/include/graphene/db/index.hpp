@@ -23,6 +23,7 @@
  */
 #pragma once
 #include <graphene/db/object.hpp>
+#include <graphene/db/type_description.hpp>
 #include <fc/interprocess/file_mapping.hpp>
 #include <fc/io/raw.hpp>
 #include <fc/io/json.hpp>
@@ -185,6 +186,8 @@ namespace graphene { namespace db {
       protected:
          vector< shared_ptr<index_observer> >   _observers;
          vector< unique_ptr<secondary_index> >  _sindex;
+         /// set by every change to the index, save() skips indexes that are unchanged since they were last opened or saved
+         bool                                   _dirty = true;
 
       private:
          object_database& _db;
@@ -214,63 +217,120 @@ namespace graphene { namespace db {
          { return object_type::type_id; }
 
          virtual object_id_type get_next_id()const override              { return _next_id;    }
-         virtual void           use_next_id()override                    { ++_next_id.number;  }
-         virtual void           set_next_id( object_id_type id )override { _next_id = id;      }
+         virtual void           use_next_id()override                    { ++_next_id.number; _dirty = true; }
+         virtual void           set_next_id( object_id_type id )override { _next_id = id; _dirty = true;     }
 
+         /**
+          * Version of the on-disk index format, derived from the reflected layout of object_type so that any change
+          * to the serialization of the objects invalidates existing index files.
+          */
          fc::sha256 get_object_version()const
          {
-            std::string desc = "1.0";//get_type_description<object_type>();
+            std::string desc = "2:" + get_type_description<object_type>();
             return fc::sha256::hash(desc);
          }
 
+         /**
+          * Index file layout: next id, object version, object count, the packed objects and finally the sha256 of
+          * everything before it.
+          */
          virtual void open( const path& db )override
          { 
             if( !fc::exists( db ) ) return;
             ilog( "open index: ${path},${spaceid},${typeid}", ("path", db.generic_string())("spaceid", object_space_id())("typeid", object_type_id()) );
             fc::file_mapping fm( db.generic_string().c_str(), fc::read_only );
             fc::mapped_region mr( fm, fc::read_only, 0, fc::file_size(db) );
-            fc::datastream<const char*> ds( (const char*)mr.get_address(), mr.get_size() );
+            const char* data = (const char*)mr.get_address();
+            FC_ASSERT( mr.get_size() >= sizeof(fc::sha256), "Truncated index file ${path}", ("path", db.generic_string()) );
+            size_t body_size = mr.get_size() - sizeof(fc::sha256);
+
+            fc::datastream<const char*> ds( data, body_size );
             fc::sha256 open_ver;
+            uint64_t count = 0;
 
             fc::raw::unpack(ds, _next_id);
             fc::raw::unpack(ds, open_ver);
             FC_ASSERT( open_ver == get_object_version(), "Incompatible Version, the serialization of objects in this index has changed" );
-            try {
-               vector<char> tmp;
-               while( true ) 
-               {
-                  fc::raw::unpack( ds, tmp );
-                  load( tmp );
-               }
-            } catch ( const fc::exception&  ){}
+
+            fc::sha256::encoder enc;
+            for( size_t pos = 0; pos < body_size; pos += 1<<24 )
+               enc.write( data + pos, std::min<size_t>( 1<<24, body_size - pos ) );
+            fc::sha256 checksum;
+            memcpy( checksum.data(), data + body_size, sizeof(checksum) );
+            FC_ASSERT( checksum == enc.result(), "Checksum mismatch in index file ${path}", ("path", db.generic_string()) );
+
+            fc::raw::unpack(ds, count);
+            for( uint64_t i = 0; i < count; ++i )
+            {
+               object_type obj;
+               fc::raw::unpack( ds, obj );
+               load( std::move(obj) );
+            }
+            FC_ASSERT( ds.remaining() == 0, "Trailing data in index file ${path}", ("path", db.generic_string()) );
+            _dirty = false;
          }
 
+         /**
+          * Writes the index to a temporary file that is renamed over db once complete, so an interrupted save
+          * leaves the previous file intact.  Does nothing if the index has not changed since it was read from or
+          * written to db.
+          */
          virtual void save( const path& db ) override 
          {
+            if( !_dirty && fc::exists( db ) ) return;
         	ilog( "save index: ${path},${spaceid},${typeid}, ${nextid}",
         			("path", db.generic_string())("spaceid", object_space_id())("typeid", object_type_id())("nextid", _next_id.number) );
-            std::ofstream out( db.generic_string(), 
+            path tmp = db.generic_string() + ".tmp";
+            std::ofstream out( tmp.generic_string(), 
                                std::ofstream::binary | std::ofstream::out | std::ofstream::trunc );
             FC_ASSERT( out );
-            auto ver  = get_object_version();
-            fc::raw::pack( out, _next_id );
-            fc::raw::pack( out, ver );
+            fc::sha256::encoder enc;
+            auto write = [&]( const vector<char>& vec ) {
+               out.write( vec.data(), vec.size() );
+               enc.write( vec.data(), vec.size() );
+            };
+
+            uint64_t count = 0;
+            this->inspect_all_objects( [&]( const object& o ) { ++count; } );
+
+            write( fc::raw::pack( _next_id ) );
+            write( fc::raw::pack( get_object_version() ) );
+            write( fc::raw::pack( count ) );
             this->inspect_all_objects( [&]( const object& o ) {
-                auto vec = fc::raw::pack( static_cast<const object_type&>(o) );
-                auto packed_vec = fc::raw::pack( vec );
-                out.write( packed_vec.data(), packed_vec.size() );
+                write( fc::raw::pack( static_cast<const object_type&>(o) ) );
             });
+            auto checksum = enc.result();
+            out.write( checksum.data(), sizeof(checksum) );
+            out.close();
+            FC_ASSERT( out, "Failed to write index file ${path}", ("path", tmp.generic_string()) );
+            fc::rename( tmp, db );
+            _dirty = false;
          }
 
          virtual const object&  load( const std::vector<char>& data )override
          {
-            const auto& result = DerivedIndex::insert( fc::raw::unpack<object_type>( data ) );
+            return load( fc::raw::unpack<object_type>( data ) );
+         }
+
+         const object&  load( object_type&& obj )
+         {
+            _dirty = true;
+            const auto& result = DerivedIndex::insert( std::move(obj) );
             for( const auto& item : _sindex )
                item->object_inserted( result );
             return result;
          }
 
 
+         virtual const object&  insert( object&& obj )override
+         {
+            _dirty = true;
+            const auto& result = DerivedIndex::insert( std::move(obj) );
+            for( const auto& item : _sindex )
+               item->object_inserted( result );
+            return result;
+         }
+
          virtual const object&  create(const std::function<void(object&)>& constructor )override
          {
             const auto& result = DerivedIndex::create( constructor );
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2015 Cryptonomex, Inc., and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+#include <fc/reflect/reflect.hpp>
+#include <fc/array.hpp>
+#include <fc/container/flat_fwd.hpp>
+#include <fc/crypto/ripemd160.hpp>
+#include <fc/crypto/sha256.hpp>
+#include <fc/io/varint.hpp>
+#include <fc/optional.hpp>
+#include <fc/smart_ref_fwd.hpp>
+#include <fc/static_variant.hpp>
+#include <fc/time.hpp>
+#include <fc/variant_object.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace graphene { namespace db {
+
+   /**
+    * Builds a textual description of the serialized layout of T from its reflection: the names of all reflected
+    * members, recursively through reflected member types and the common containers.  Hashing the result gives a
+    * schema version that changes whenever a reflected field is added, removed, renamed or reordered.  Every other
+    * type needs a specialization below, describing a type that has neither is a compile error.
+    */
+   template<typename T, typename Enable = void>
+   struct type_description
+   {
+      static_assert( sizeof(T) == 0, "type_description needs FC_REFLECT or a specialization for this type" );
+   };
+
+   namespace detail {
+      struct type_description_visitor
+      {
+         type_description_visitor( std::string& d, uint32_t dep ):desc(d),depth(dep){}
+
+         template<typename Member, class Class, Member (Class::*member)>
+         void operator()( const char* name )const
+         {
+            desc += name;
+            desc += ':';
+            type_description<Member>::append( desc, depth );
+            desc += ';';
+         }
+
+         std::string& desc;
+         uint32_t     depth;
+      };
+   }
+
+   template<typename T>
+   struct type_description<T, typename std::enable_if<fc::reflector<T>::is_defined::value && !fc::reflector<T>::is_enum::value>::type>
+   {
+      static void append( std::string& desc, uint32_t depth )
+      {
+         // guard against self-referencing types, their nested layout is covered by the outer levels
+         if( depth >= 16 ) { desc += "..."; return; }
+         desc += '{';
+         fc::reflector<T>::visit( detail::type_description_visitor( desc, depth + 1 ) );
+         desc += '}';
+      }
+   };
+
+   template<typename T>
+   struct type_description<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+   {
+      static void append( std::string& desc, uint32_t )
+      {
+         desc += std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+         desc += std::to_string( sizeof(T) );
+      }
+   };
+
+   template<typename T>
+   struct type_description<T, typename std::enable_if<std::is_enum<T>::value>::type>
+   {
+      static void append( std::string& desc, uint32_t ) { desc += 'e' + std::to_string( sizeof(T) ); }
+   };
+
+   template<typename T, size_t N>
+   struct type_description<fc::array<T,N>>
+   {
+      static void append( std::string& desc, uint32_t depth )
+      {
+         desc += '[';
+         type_description<T>::append( desc, depth );
+         desc += '*' + std::to_string( N ) + ']';
+      }
+   };
+
+   template<typename T>
+   struct type_description<fc::smart_ref<T>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { type_description<T>::append( desc, depth ); }
+   };
+
+   template<typename... T>
+   struct type_description<fc::static_variant<T...>>
+   {
+      static void append( std::string& desc, uint32_t depth )
+      {
+         desc += '(';
+         // one entry per alternative in tag order, the tag is part of the serialization
+         int expand[] = { 0, ( type_description<T>::append( desc, depth ), desc += '|', 0 )... };
+         (void)expand;
+         desc += ')';
+      }
+   };
+
+#define GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( TYPE, NAME ) \
+   template<> \
+   struct type_description<TYPE> \
+   { \
+      static void append( std::string& desc, uint32_t ) { desc += NAME; } \
+   };
+
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( std::string,        "string" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::unsigned_int,   "varuint" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::time_point_sec, "time_point_sec" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::ripemd160,      "ripemd160" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::sha256,         "sha256" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::variant,        "variant" )
+   GRAPHENE_DB_NAMED_TYPE_DESCRIPTION( fc::variant_object, "variant_object" )
+
+#undef GRAPHENE_DB_NAMED_TYPE_DESCRIPTION
+
+   template<typename T>
+   struct type_description<std::vector<T>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '['; type_description<T>::append( desc, depth ); desc += ']'; }
+   };
+
+   template<typename T>
+   struct type_description<fc::optional<T>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '?'; type_description<T>::append( desc, depth ); }
+   };
+
+   template<typename T>
+   struct type_description<std::set<T>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '<'; type_description<T>::append( desc, depth ); desc += '>'; }
+   };
+
+   template<typename T, typename... A>
+   struct type_description<boost::container::flat_set<T, A...>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '<'; type_description<T>::append( desc, depth ); desc += '>'; }
+   };
+
+   template<typename K, typename V>
+   struct type_description<std::pair<K,V>>
+   {
+      static void append( std::string& desc, uint32_t depth )
+      {
+         desc += '(';
+         type_description<K>::append( desc, depth );
+         desc += ',';
+         type_description<V>::append( desc, depth );
+         desc += ')';
+      }
+   };
+
+   template<typename K, typename V, typename... A>
+   struct type_description<std::map<K, V, A...>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '<'; type_description<std::pair<K,V>>::append( desc, depth ); desc += '>'; }
+   };
+
+   template<typename K, typename V, typename... A>
+   struct type_description<boost::container::flat_map<K, V, A...>>
+   {
+      static void append( std::string& desc, uint32_t depth ) { desc += '<'; type_description<std::pair<K,V>>::append( desc, depth ); desc += '>'; }
+   };
+
+   template<typename T>
+   std::string get_type_description()
+   {
+      std::string desc = fc::get_typename<T>::name();
+      type_description<T>::append( desc, 0 );
+      return desc;
+   }
+
+} } // graphene::db
@@ -134,17 +134,35 @@ namespace graphene { namespace db {
 
          void set_reindex_status(bool is_in_progess){_reindex_in_progress=is_in_progess;}
 
+         /// Number of spare copies kept per object type for reuse by later sessions
+         void set_max_pooled_objects( size_t n ) { _max_pooled_objects = n; }
+
       private:
          void undo();
          void merge();
          void commit();
 
+         /// copy of obj, built in a recycled object of its type when one is available
+         unique_ptr<object> snapshot( const object& obj );
+         /// keep an undo copy that is no longer needed for the next snapshot() of its type
+         void recycle( unique_ptr<object>&& obj );
+         void recycle_state( undo_state&& state );
+         void push_state();
+
          uint32_t                _active_sessions = 0;
          bool                    _disabled = true;
          std::deque<undo_state>  _stack;
          object_database&        _db;
          size_t                  _max_size = 256;
          bool                    _reindex_in_progress = false;
+
+         /**
+          *  Spare objects by (space, type) and emptied undo states.  Every modification used to allocate a fresh
+          *  copy and every discarded session freed them all again; now both are recycled.
+          */
+         unordered_map<uint16_t, vector<unique_ptr<object>>> _object_pool;
+         vector<undo_state>      _state_pool;
+         size_t                  _max_pooled_objects = 1024;
    };
 
 } } // graphene::db
@@ -26,6 +26,9 @@
 #include <fc/io/raw.hpp>
 #include <fc/container/flat.hpp>
 #include <fc/uint128.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <thread>
 
 namespace graphene { namespace db {
 
@@ -93,10 +96,30 @@ void object_database::open(const fc::path& data_dir)
 { try {
    ilog("Opening object database from ${d} ...", ("d", data_dir));
    _data_dir = data_dir;
+
+   // indexes do not reference each other while loading, so they are read in parallel
+   vector<index*> indexes;
    for( uint32_t space = 0; space < _index.size(); ++space )
       for( uint32_t type = 0; type  < _index[space].size(); ++type )
          if( _index[space][type] )
-            _index[space][type]->open( _data_dir / "object_database" / fc::to_string(space)/fc::to_string(type) );
+            indexes.push_back( _index[space][type].get() );
+
+   size_t thread_count = std::max<size_t>( 1, std::min<size_t>( 8, std::thread::hardware_concurrency() ) );
+   vector<std::unique_ptr<fc::thread>> threads;
+   for( size_t i = 0; i < thread_count; ++i )
+      threads.emplace_back( new fc::thread( "db_open_" + fc::to_string( uint64_t(i) ) ) );
+
+   vector<fc::future<void>> loaded;
+   for( size_t i = 0; i < indexes.size(); ++i )
+   {
+      index* idx = indexes[i];
+      fc::path file = _data_dir / "object_database" / fc::to_string(idx->object_space_id()) / fc::to_string(idx->object_type_id());
+      loaded.push_back( threads[i % thread_count]->async( [idx, file]{ idx->open( file ); }, "open_index" ) );
+   }
+   for( auto& f : loaded )
+      f.wait();
+   for( auto& t : threads )
+      t->quit();
    ilog( "Done opening object database." );
 
 } FC_CAPTURE_AND_RETHROW( (data_dir) ) }
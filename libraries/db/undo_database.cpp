@@ -38,9 +38,12 @@ undo_database::session undo_database::start_undo_session( bool force_enable )
       _disabled = false;
 
    while( size() > max_size() )
+   {
+      recycle_state( std::move( _stack.front() ) );
       _stack.pop_front();
+   }
 
-   _stack.emplace_back();
+   push_state();
    ++_active_sessions;
    return session(*this, disable_on_exit );
 }
@@ -49,7 +52,7 @@ void undo_database::on_create( const object& obj )
    if( _disabled ) return;
 
    if( _stack.empty() )
-      _stack.emplace_back();
+      push_state();
    auto& state = _stack.back();
    auto index_id = object_id_type( obj.id.space(), obj.id.type(), 0 );
    auto itr = state.old_index_next_ids.find( index_id );
@@ -62,20 +65,20 @@ void undo_database::on_modify( const object& obj )
    if( _disabled ) return;
 
    if( _stack.empty() )
-      _stack.emplace_back();
+      push_state();
    auto& state = _stack.back();
    if( state.new_ids.find(obj.id) != state.new_ids.end() )
       return;
    auto itr =  state.old_values.find(obj.id);
    if( itr != state.old_values.end() ) return;
-   state.old_values[obj.id] = obj.clone();
+   state.old_values[obj.id] = snapshot( obj );
 }
 void undo_database::on_remove( const object& obj )
 {
    if( _disabled ) return;
 
    if( _stack.empty() )
-      _stack.emplace_back();
+      push_state();
    undo_state& state = _stack.back();
    if( state.new_ids.count(obj.id) )
    {
@@ -89,7 +92,7 @@ void undo_database::on_remove( const object& obj )
       return;
    }
    if( state.removed.count(obj.id) ) return;
-   state.removed[obj.id] = obj.clone();
+   state.removed[obj.id] = snapshot( obj );
 }
 
 void undo_database::undo()
@@ -119,6 +122,7 @@ void undo_database::undo()
    for( auto& item : state.removed )
       _db.insert( std::move(*item.second) );
 
+   recycle_state( std::move( state ) );
    _stack.pop_back();
 /*原来的代码中，undo_database的栈在大小为0时自动插入一个空元素，导致被请求同步的节点在提供同步时访问越界导致的。注释该部分代码后问题解决。后面需要观察这样改动是否会有其它副作用
    if( _stack.empty() )
@@ -136,6 +140,7 @@ void undo_database::merge()
       if(_stack.size() == 1)
       {
          ilog("undo db merge during reindexing and stack size is 1");
+         recycle_state( std::move( _stack.back() ) );
          _stack.pop_back();
          --_active_sessions;
          return;
@@ -249,6 +254,8 @@ void undo_database::merge()
       // nop + del(was=Y) -> del(was=Y)
       prev_state.removed[obj.second->id] = std::move(obj.second);
    }
+   // copies that did not move into prev_state are spare now
+   recycle_state( std::move( state ) );
    _stack.pop_back();
    --_active_sessions;
 }
@@ -285,6 +292,7 @@ void undo_database::pop_commit()
       for( auto& item : state.removed )
          _db.insert( std::move(*item.second) );
 
+      recycle_state( std::move( state ) );
       _stack.pop_back();
    }
    catch ( const fc::exception& e )
@@ -295,6 +303,55 @@ void undo_database::pop_commit()
    }
    enable();
 }
+unique_ptr<object> undo_database::snapshot( const object& obj )
+{
+   auto itr = _object_pool.find( uint16_t(obj.id.space()) << 8 | obj.id.type() );
+   if( itr == _object_pool.end() || itr->second.empty() )
+      return obj.clone();
+   unique_ptr<object> copy = std::move( itr->second.back() );
+   itr->second.pop_back();
+   copy->copy_from( obj );
+   return copy;
+}
+
+void undo_database::recycle( unique_ptr<object>&& obj )
+{
+   if( !obj )
+      return;
+   // the space and type survive a move out of the object, and every object of a space and type has the same class
+   auto& pool = _object_pool[uint16_t(obj->id.space()) << 8 | obj->id.type()];
+   if( pool.size() < _max_pooled_objects )
+      pool.push_back( std::move( obj ) );
+   obj.reset();
+}
+
+void undo_database::recycle_state( undo_state&& state )
+{
+   for( auto& item : state.old_values )
+      recycle( std::move( item.second ) );
+   for( auto& item : state.removed )
+      recycle( std::move( item.second ) );
+   if( _state_pool.size() >= 8 )
+      return;
+   // clear() keeps the bucket arrays for the next session
+   state.old_values.clear();
+   state.old_index_next_ids.clear();
+   state.new_ids.clear();
+   state.removed.clear();
+   _state_pool.push_back( std::move( state ) );
+}
+
+void undo_database::push_state()
+{
+   if( _state_pool.empty() )
+   {
+      _stack.emplace_back();
+      return;
+   }
+   _stack.push_back( std::move( _state_pool.back() ) );
+   _state_pool.pop_back();
+}
+
 const undo_state& undo_database::head()const
 {
    FC_ASSERT( !_stack.empty() );
@@ -18,6 +18,10 @@ class file_appender : public appender {
             bool                               rotate = false;
             microseconds                       rotation_interval;
             microseconds                       rotation_limit;
+            /// format and write messages on a background thread instead of the logging one
+            bool                               async = false;
+            /// messages waiting for the background thread, further ones are dropped and counted
+            uint32_t                           queue_size = 65536;
          };
          file_appender( const variant& args );
          ~file_appender();
@@ -31,4 +35,4 @@ class file_appender : public appender {
 
 #include <fc/reflect/reflect.hpp>
 FC_REFLECT( fc::file_appender::config,
-            (format)(filename)(flush)(rotate)(rotation_interval)(rotation_limit) )
+            (format)(filename)(flush)(rotate)(rotation_interval)(rotation_limit)(async)(queue_size) )
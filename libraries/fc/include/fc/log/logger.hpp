@@ -4,6 +4,8 @@
 #include <fc/shared_ptr.hpp>
 #include <fc/log/log_message.hpp>
 
+#include <atomic>
+
 namespace fc  
 {
 
@@ -55,6 +57,27 @@ namespace fc
          fc::shared_ptr<impl> my;
    };
 
+   /**
+    *  Lets at most a fixed number of messages per second through one call site,
+    *  see elog_limited().  Messages over the limit are dropped without being formatted.
+    */
+   class log_rate_limiter
+   {
+      public:
+         bool allow( uint32_t max_per_second )
+         {
+            int64_t now = fc::time_point::now().sec_since_epoch();
+            int64_t window = _window.load( std::memory_order_relaxed );
+            if( now != window && _window.compare_exchange_strong( window, now, std::memory_order_relaxed ) )
+               _count.store( 0, std::memory_order_relaxed );
+            return _count.fetch_add( 1, std::memory_order_relaxed ) < max_per_second;
+         }
+
+      private:
+         std::atomic<int64_t>  _window{0};
+         std::atomic<uint32_t> _count{0};
+   };
+
 } // namespace fc
 
 #ifndef DEFAULT_LOGGER
@@ -162,6 +185,26 @@ namespace fc
 #define FC_FORMAT_ARG_PARAMS( ... )\
     BOOST_PP_SEQ_FOR_EACH( FC_FORMAT_ARGS, v, __VA_ARGS__ ) 
 
+#define FC_LOG_LIMITED( LEVEL, MAX_PER_SECOND, FORMAT, ... ) \
+  FC_MULTILINE_MACRO_BEGIN \
+   static fc::log_rate_limiter fc_log_rate_limiter; \
+   if( fc_log_rate_limiter.allow( MAX_PER_SECOND ) && \
+       (fc::logger::get(DEFAULT_LOGGER)).is_enabled( fc::log_level::LEVEL ) ) \
+      (fc::logger::get(DEFAULT_LOGGER)).log( FC_LOG_MESSAGE( LEVEL, FORMAT, __VA_ARGS__ ) ); \
+  FC_MULTILINE_MACRO_END
+
+/// Like ilog/wlog/elog but at most MAX_PER_SECOND messages per second from this call site
+#define ilog_limited( MAX_PER_SECOND, FORMAT, ... ) FC_LOG_LIMITED( info, MAX_PER_SECOND, FORMAT, __VA_ARGS__ )
+#define wlog_limited( MAX_PER_SECOND, FORMAT, ... ) FC_LOG_LIMITED( warn, MAX_PER_SECOND, FORMAT, __VA_ARGS__ )
+#define elog_limited( MAX_PER_SECOND, FORMAT, ... ) FC_LOG_LIMITED( error, MAX_PER_SECOND, FORMAT, __VA_ARGS__ )
+
+/// Tracing for hot paths, compiled in only when building with -DLOG_DEBUG
+#ifdef LOG_DEBUG
+# define tlog( FORMAT, ... ) ilog( FORMAT, __VA_ARGS__ )
+#else
+# define tlog(...) FC_MULTILINE_MACRO_BEGIN FC_MULTILINE_MACRO_END
+#endif
+
 #define idump( SEQ ) \
     ilog( FC_FORMAT(SEQ), FC_FORMAT_ARG_PARAMS(SEQ) )  
 #define wdump( SEQ ) \
@@ -183,4 +226,8 @@ namespace fc
 # define ilog(...) FC_MULTILINE_MACRO_BEGIN FC_MULTILINE_MACRO_END
 # undef dlog
 # define dlog(...) FC_MULTILINE_MACRO_BEGIN FC_MULTILINE_MACRO_END
+# undef FC_LOG_LIMITED
+# define FC_LOG_LIMITED(...) FC_MULTILINE_MACRO_BEGIN FC_MULTILINE_MACRO_END
+# undef tlog
+# define tlog(...) FC_MULTILINE_MACRO_BEGIN FC_MULTILINE_MACRO_END
 #endif
\ No newline at end of file
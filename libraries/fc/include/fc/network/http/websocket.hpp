@@ -19,11 +19,22 @@ namespace fc { namespace http {
       public:
          virtual ~websocket_connection(){}
          virtual void send_message( const std::string& message ) = 0;
+         /// Sends message in a binary frame, connections without binary frames send it as text
+         virtual void send_binary_message( const std::string& message ) { send_message( message ); }
          virtual void close( int64_t code, const std::string& reason  ){};
          void on_message( const std::string& message ) { _on_message(message); }
+         /// Binary frames go to the binary message handler if one is set, to the message handler otherwise
+         void on_binary_message( const std::string& message )
+         {
+            if( _on_binary_message )
+               _on_binary_message(message);
+            else
+               _on_message(message);
+         }
          string on_http( const std::string& message ) { return _on_http(message); }
 
          void on_message_handler( const std::function<void(const std::string&)>& h ) { _on_message = h; }
+         void on_binary_message_handler( const std::function<void(const std::string&)>& h ) { _on_binary_message = h; }
          void on_http_handler( const std::function<std::string(const std::string&)>& h ) { _on_http = h; }
 
          void     set_session_data( fc::any d ){ _session_data = std::move(d); }
@@ -35,6 +46,7 @@ namespace fc { namespace http {
       private:
          fc::any                                   _session_data;
          std::function<void(const std::string&)>   _on_message;
+         std::function<void(const std::string&)>   _on_binary_message;
          std::function<string(const std::string&)> _on_http;
    };
    typedef std::shared_ptr<websocket_connection> websocket_connection_ptr;
@@ -0,0 +1,141 @@
+#pragma once
+#include <fc/api.hpp>
+#include <fc/any.hpp>
+#include <fc/io/raw.hpp>
+#include <fc/io/raw_variant.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+
+namespace fc { namespace rpc {
+
+   /**
+    *  Header of a call in a binary frame, followed by the arguments of the method packed one after
+    *  the other with fc::raw.
+    */
+   struct raw_request
+   {
+      uint64_t    id = 0;
+      std::string api;
+      std::string method;
+   };
+
+   /**
+    *  Header of the reply to a raw_request in a binary frame, followed by the packed result of the
+    *  method, or by the packed error message when error is true.
+    */
+   struct raw_response
+   {
+      uint64_t    id = 0;
+      bool        error = false;
+   };
+
+   namespace detail {
+      template<typename T>
+      struct is_raw_value : std::true_type {};
+      template<typename Signature>
+      struct is_raw_value< std::function<Signature> > : std::false_type {};
+      template<typename Interface, typename Transform>
+      struct is_raw_value< fc::api<Interface,Transform> > : std::false_type {};
+      template<typename Interface, typename Transform>
+      struct is_raw_value< fc::optional< fc::api<Interface,Transform> > > : std::false_type {};
+      template<>
+      struct is_raw_value< fc::api_ptr > : std::false_type {};
+
+      template<typename... T>
+      struct all_raw_values : std::true_type {};
+      template<typename T, typename... Rest>
+      struct all_raw_values<T, Rest...>
+         : std::integral_constant< bool, is_raw_value< typename std::decay<T>::type >::value && all_raw_values<Rest...>::value > {};
+   }
+
+   /**
+    *  Calls the methods of an fc::api with arguments and results packed with fc::raw instead of
+    *  going through fc::variant.  Results are packed straight into the frame that is sent back.
+    *
+    *  Methods taking callbacks or returning other apis are not available this way.
+    */
+   class raw_api
+   {
+      public:
+         /// Unpacks the arguments from args and appends the packed result to frame
+         typedef std::function<void( fc::datastream<const char*>& args, std::string& frame )> method_type;
+
+         template<typename Api>
+         explicit raw_api( const Api& a ) : _api( a )
+         {
+            a->visit( visitor{ *this } );
+         }
+
+         void call( const std::string& method, fc::datastream<const char*>& args, std::string& frame )const
+         {
+            auto itr = _methods.find( method );
+            FC_ASSERT( itr != _methods.end(), "no method with name '${name}'", ("name", method) );
+            itr->second( args, frame );
+         }
+
+         bool has_method( const std::string& method )const { return _methods.find( method ) != _methods.end(); }
+
+      private:
+         template<typename T>
+         static void append( std::string& frame, const T& value )
+         {
+            size_t offset = frame.size();
+            size_t size = fc::raw::pack_size( value );
+            frame.resize( offset + size );
+            fc::datastream<char*> ds( &frame[offset], size );
+            fc::raw::pack( ds, value );
+         }
+
+         template<typename R>
+         static void call_with( const std::function<R()>& f, fc::datastream<const char*>&, std::string& frame )
+         {
+            append( frame, f() );
+         }
+
+         static void call_with( const std::function<void()>& f, fc::datastream<const char*>&, std::string& )
+         {
+            f();
+         }
+
+         template<typename R, typename Arg0, typename... Args>
+         static void call_with( const std::function<R(Arg0, Args...)>& f, fc::datastream<const char*>& ds, std::string& frame )
+         {
+            typename std::decay<Arg0>::type a0;
+            fc::raw::unpack( ds, a0 );
+            call_with( std::function<R(Args...)>( [&f, &a0]( Args... args ) -> R { return f( a0, args... ); } ), ds, frame );
+         }
+
+         struct visitor
+         {
+            raw_api& api;
+
+            template<typename R, typename... Args>
+            void operator()( const char* name, std::function<R(Args...)>& memb )const
+            {
+               add( name, memb, detail::all_raw_values<R, Args...>() );
+            }
+
+            template<typename R, typename... Args>
+            void add( const char* name, const std::function<R(Args...)>& memb, std::true_type )const
+            {
+               api._methods[name] = [memb]( fc::datastream<const char*>& args, std::string& frame ) {
+                  call_with( memb, args, frame );
+               };
+            }
+
+            template<typename R, typename... Args>
+            void add( const char*, const std::function<R(Args...)>&, std::false_type )const {}
+         };
+
+         fc::any                              _api;
+         std::map< std::string, method_type > _methods;
+   };
+
+} } // namespace fc::rpc
+
+FC_REFLECT( fc::rpc::raw_request, (id)(api)(method) )
+FC_REFLECT( fc::rpc::raw_response, (id)(error) )
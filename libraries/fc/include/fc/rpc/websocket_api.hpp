@@ -1,5 +1,6 @@
 #pragma once
 #include <fc/rpc/api_connection.hpp>
+#include <fc/rpc/raw_api.hpp>
 #include <fc/rpc/state.hpp>
 #include <fc/network/http/websocket.hpp>
 #include <fc/io/json.hpp>
@@ -24,13 +25,25 @@ namespace fc { namespace rpc {
             uint64_t callback_id,
             variants args = variants() ) override;
 
+         /**
+          *  Serves the methods of a under name to calls in binary frames, see raw_api.  Until an api is
+          *  registered this way binary frames are read as JSON like text frames.
+          */
+         template<typename Api>
+         void register_raw_api( const std::string& name, const Api& a )
+         {
+            _raw_apis[name] = std::make_shared<raw_api>( a );
+         }
+
       protected:
          std::string on_message(
             const std::string& message,
             bool send_message = true );
+         void on_binary_message( const std::string& message );
 
          fc::http::websocket_connection&  _connection;
          fc::rpc::state                   _rpc_state;
+         std::map< std::string, std::shared_ptr<raw_api> > _raw_apis;
    };
 
 } } // namespace fc::rpc
@@ -6,12 +6,53 @@
 #include <fc/thread/thread.hpp>
 #include <fc/variant.hpp>
 #include <boost/thread/mutex.hpp>
+#include <condition_variable>
+#include <iostream>
 #include <iomanip>
+#include <mutex>
 #include <queue>
 #include <sstream>
+#include <thread>
 
 namespace fc {
 
+   namespace {
+      // MS THREAD METHOD  MESSAGE \t\t\t File:Line
+      string format_line( const log_message& m )
+      {
+         std::stringstream line;
+         //line << (m.get_context().get_timestamp().time_since_epoch().count() % (1000ll*1000ll*60ll*60))/1000 <<"ms ";
+         line << string(m.get_context().get_timestamp()) << " ";
+         line << std::setw( 21 ) << (m.get_context().get_thread_name().substr(0,9) + string(":") + m.get_context().get_task_name()).c_str() << " ";
+
+         string method_name = m.get_context().get_method();
+         // strip all leading scopes...
+         if( method_name.size() )
+         {
+            uint32_t p = 0;
+            for( uint32_t i = 0;i < method_name.size(); ++i )
+            {
+                if( method_name[i] == ':' ) p = i;
+            }
+
+            if( method_name[p] == ':' )
+              ++p;
+            line << std::setw( 20 ) << m.get_context().get_method().substr(p,20).c_str() <<" ";
+         }
+
+         line << "] ";
+         fc::string message = fc::format_string( m.get_format(), m.get_data() );
+         line << message.c_str();
+
+         //fc::variant lmsg(m);
+
+         // fc::string fmt_str = fc::format_string( my->cfg.format, mutable_variant_object(m.get_context())( "message", message)  );
+
+         line << "\t\t\t" << m.get_context().get_file() << ":" << m.get_context().get_line_number() << "\n";
+         return line.str();
+      }
+   }
+
    class file_appender::impl : public fc::retainable
    {
       public:
@@ -19,6 +60,16 @@ namespace fc {
          ofstream                   out;
          boost::mutex               slock;
 
+         // async mode: a fixed ring of messages drained by _writer
+         std::mutex                 qlock;
+         std::condition_variable    qready;
+         std::vector<log_message>   ring;
+         size_t                     ring_head = 0;
+         size_t                     ring_count = 0;
+         uint64_t                   dropped = 0;
+         bool                       stopping = false;
+         std::thread                _writer;
+
       private:
          future<void>               _rotation_task;
          time_point_sec             _current_file_start_time;
@@ -43,10 +94,25 @@ namespace fc {
 
                  _rotation_task = async( [this]() { rotate_files( true ); }, "rotate_files(1)" );
              }
+             if( cfg.async )
+             {
+                 FC_ASSERT( cfg.queue_size > 0 );
+                 ring.resize( cfg.queue_size );
+                 _writer = std::thread( [this]() { write_queued(); } );
+             }
          }
 
          ~impl()
          {
+            if( _writer.joinable() )
+            {
+               {
+                  std::lock_guard<std::mutex> guard( qlock );
+                  stopping = true;
+               }
+               qready.notify_one();
+               _writer.join();
+            }
             try
             {
               _rotation_task.cancel_and_wait("file_appender is destructing");
@@ -56,6 +122,55 @@ namespace fc {
             }
          }
 
+         void write( const string& line )
+         {
+            fc::scoped_lock<boost::mutex> lock( slock );
+            out << line;
+            if( cfg.flush )
+              out.flush();
+         }
+
+         void enqueue( const log_message& m )
+         {
+            {
+               std::lock_guard<std::mutex> guard( qlock );
+               if( ring_count == ring.size() )
+               {
+                  ++dropped;
+                  return;
+               }
+               ring[(ring_head + ring_count) % ring.size()] = m;
+               ++ring_count;
+            }
+            qready.notify_one();
+         }
+
+         void write_queued()
+         {
+            std::vector<log_message> batch;
+            while( true )
+            {
+               uint64_t batch_dropped = 0;
+               {
+                  std::unique_lock<std::mutex> guard( qlock );
+                  qready.wait( guard, [this]() { return ring_count > 0 || stopping; } );
+                  if( ring_count == 0 )
+                     return;
+                  for( ; ring_count > 0; --ring_count, ring_head = (ring_head + 1) % ring.size() )
+                     batch.push_back( std::move( ring[ring_head] ) );
+                  std::swap( batch_dropped, dropped );
+               }
+
+               std::stringstream lines;
+               for( const auto& m : batch )
+                  lines << format_line( m );
+               if( batch_dropped )
+                  lines << string(time_point::now()) << " " << batch_dropped << " log messages dropped, queue full\n";
+               batch.clear();
+               write( lines.str() );
+            }
+         }
+
          void rotate_files( bool initializing = false )
          {
              FC_ASSERT( cfg.rotate );
@@ -156,43 +271,12 @@ namespace fc {
 
    file_appender::~file_appender(){}
 
-   // MS THREAD METHOD  MESSAGE \t\t\t File:Line
    void file_appender::log( const log_message& m )
    {
-      std::stringstream line;
-      //line << (m.get_context().get_timestamp().time_since_epoch().count() % (1000ll*1000ll*60ll*60))/1000 <<"ms ";
-      line << string(m.get_context().get_timestamp()) << " ";
-      line << std::setw( 21 ) << (m.get_context().get_thread_name().substr(0,9) + string(":") + m.get_context().get_task_name()).c_str() << " ";
-
-      string method_name = m.get_context().get_method();
-      // strip all leading scopes...
-      if( method_name.size() )
-      {
-         uint32_t p = 0;
-         for( uint32_t i = 0;i < method_name.size(); ++i )
-         {
-             if( method_name[i] == ':' ) p = i;
-         }
-
-         if( method_name[p] == ':' )
-           ++p;
-         line << std::setw( 20 ) << m.get_context().get_method().substr(p,20).c_str() <<" ";
-      }
-
-      line << "] ";
-      fc::string message = fc::format_string( m.get_format(), m.get_data() );
-      line << message.c_str();
-
-      //fc::variant lmsg(m);
-
-      // fc::string fmt_str = fc::format_string( my->cfg.format, mutable_variant_object(m.get_context())( "message", message)  );
-
-      {
-        fc::scoped_lock<boost::mutex> lock( my->slock );
-        my->out << line.str() << "\t\t\t" << m.get_context().get_file() << ":" << m.get_context().get_line_number() << "\n";
-        if( my->cfg.flush )
-          my->out.flush();
-      }
+      if( my->cfg.async )
+         my->enqueue( m );
+      else
+         my->write( format_line( m ) );
    }
 
 } // fc
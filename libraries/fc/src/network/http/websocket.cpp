@@ -163,6 +163,11 @@ namespace fc { namespace http {
                auto ec = _ws_connection->send( message );
                FC_ASSERT( !ec, "websocket send failed: ${msg}", ("msg",ec.message() ) );
             }
+            virtual void send_binary_message( const std::string& message )override
+            {
+               auto ec = _ws_connection->send( message, websocketpp::frame::opcode::binary );
+               FC_ASSERT( !ec, "websocket send failed: ${msg}", ("msg",ec.message() ) );
+            }
             virtual void close( int64_t code, const std::string& reason  )override
             {
                _ws_connection->close(code,reason);
@@ -201,9 +206,16 @@ namespace fc { namespace http {
                        wdump(("server")(msg->get_payload()));
                        //std::cerr<<"recv: "<<msg->get_payload()<<"\n";
                        auto payload = msg->get_payload();
+                       bool binary = msg->get_opcode() == websocketpp::frame::opcode::binary;
                        std::shared_ptr<websocket_connection> con = current_con->second;
                        ++_pending_messages;
-                       auto f = fc::async([this,con,payload](){ if( _pending_messages ) --_pending_messages; con->on_message( payload ); });
+                       auto f = fc::async([this,con,payload,binary](){
+                          if( _pending_messages ) --_pending_messages;
+                          if( binary )
+                             con->on_binary_message( payload );
+                          else
+                             con->on_message( payload );
+                       });
                        if( _pending_messages > 100 ) 
                          f.wait();
                     }).wait();
@@ -333,8 +345,14 @@ namespace fc { namespace http {
                        auto current_con = _connections.find(hdl);
                        assert( current_con != _connections.end() );
                        auto received = msg->get_payload();
+                       bool binary = msg->get_opcode() == websocketpp::frame::opcode::binary;
                        std::shared_ptr<websocket_connection> con = current_con->second;
-                       fc::async([con,received](){ con->on_message( received ); });
+                       fc::async([con,received,binary](){
+                          if( binary )
+                             con->on_binary_message( received );
+                          else
+                             con->on_message( received );
+                       });
                     }).wait();
                });
 
@@ -48,6 +48,7 @@ websocket_api_connection::websocket_api_connection( fc::http::websocket_connecti
    } );
 
    _connection.on_message_handler( [&]( const std::string& msg ){ on_message(msg,true); } );
+   _connection.on_binary_message_handler( [&]( const std::string& msg ){ on_binary_message(msg); } );
    _connection.on_http_handler( [&]( const std::string& msg ){ return on_message(msg,false); } );
    _connection.closed.connect( [this](){ closed(); } );
 }
@@ -158,4 +159,48 @@ std::string websocket_api_connection::on_message(
    return string();
 }
 
+void websocket_api_connection::on_binary_message( const std::string& message )
+{
+   if( _raw_apis.empty() )
+   {
+      on_message( message, true );
+      return;
+   }
+
+   raw_response reply;
+   std::string frame;
+   fc::optional<std::string> error;
+   try
+   {
+      fc::datastream<const char*> ds( message.data(), message.size() );
+      raw_request call;
+      fc::raw::unpack( ds, call );
+      reply.id = call.id;
+
+      auto itr = _raw_apis.find( call.api );
+      FC_ASSERT( itr != _raw_apis.end(), "no api with name '${name}'", ("name",call.api) );
+      auto header = fc::raw::pack( reply );
+      frame.assign( header.begin(), header.end() );
+      itr->second->call( call.method, ds, frame );
+   }
+   catch ( const fc::exception& e )
+   {
+      error = e.to_string();
+   }
+   catch ( const std::exception& e )
+   {
+      error = std::string( e.what() );
+   }
+
+   if( error )
+   {
+      reply.error = true;
+      auto packed = fc::raw::pack( reply );
+      auto packed_error = fc::raw::pack( *error );
+      frame.assign( packed.begin(), packed.end() );
+      frame.append( packed_error.begin(), packed_error.end() );
+   }
+   _connection.send_binary_message( frame );
+}
+
 } } // namespace fc::rpc
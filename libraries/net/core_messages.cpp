@@ -45,6 +45,19 @@ namespace graphene { namespace net {
   const core_message_type_enum check_firewall_reply_message::type            = core_message_type_enum::check_firewall_reply_message_type;
   const core_message_type_enum get_current_connections_request_message::type = core_message_type_enum::get_current_connections_request_message_type;
   const core_message_type_enum get_current_connections_reply_message::type   = core_message_type_enum::get_current_connections_reply_message_type;
+  const core_message_type_enum compact_block_message::type                   = core_message_type_enum::compact_block_message_type;
+  const core_message_type_enum fetch_compact_block_transactions_message::type = core_message_type_enum::fetch_compact_block_transactions_message_type;
+  const core_message_type_enum compact_block_transactions_message::type      = core_message_type_enum::compact_block_transactions_message_type;
+
+  compact_block_message::compact_block_message(const block_message& full, const item_hash_t& block_message_hash) :
+    block_message_hash(block_message_hash),
+    block_id(full.block_id),
+    header(full.block)
+  {
+    transactions.reserve(full.block.transactions.size());
+    for (const graphene::chain::processed_transaction& trx : full.block.transactions)
+      transactions.push_back(compact_block_transaction{trx.id(), trx.operation_results});
+  }
 
 } } // graphene::net
 
@@ -86,6 +86,9 @@ namespace graphene { namespace net {
     check_firewall_reply_message_type            = 5015,
     get_current_connections_request_message_type = 5016,
     get_current_connections_reply_message_type   = 5017,
+    compact_block_message_type                   = 5018,
+    fetch_compact_block_transactions_message_type = 5019,
+    compact_block_transactions_message_type      = 5020,
     core_message_type_last                       = 5099
   };
 
@@ -115,6 +118,52 @@ namespace graphene { namespace net {
 
    };
 
+  struct compact_block_transaction
+  {
+    transaction_id_type                             id;
+    std::vector<graphene::chain::operation_result>  operation_results;
+  };
+
+  /**
+   * A block sent during normal operation as its header and the ids of its transactions, to peers that
+   * announced compact block support in their hello.  The receiver rebuilds the block_message from
+   * transactions it already has and asks for the others with fetch_compact_block_transactions_message.
+   */
+  struct compact_block_message
+  {
+    static const core_message_type_enum type;
+
+    item_hash_t                             block_message_hash; ///< id() of the block_message this stands for
+    block_id_type                           block_id;
+    graphene::chain::signed_block_header    header;
+    std::vector<compact_block_transaction>  transactions;
+
+    compact_block_message() {}
+    compact_block_message(const block_message& full, const item_hash_t& block_message_hash);
+  };
+
+  struct fetch_compact_block_transactions_message
+  {
+    static const core_message_type_enum type;
+
+    item_hash_t            block_message_hash;
+    std::vector<uint32_t>  indexes; ///< positions in compact_block_message::transactions
+
+    fetch_compact_block_transactions_message() {}
+    fetch_compact_block_transactions_message(const item_hash_t& block_message_hash, std::vector<uint32_t> indexes) :
+      block_message_hash(block_message_hash),
+      indexes(std::move(indexes))
+    {}
+  };
+
+  struct compact_block_transactions_message
+  {
+    static const core_message_type_enum type;
+
+    item_hash_t                      block_message_hash;
+    std::vector<signed_transaction>  transactions; ///< in the order of the request's indexes
+  };
+
   struct item_ids_inventory_message
   {
     static const core_message_type_enum type;
@@ -424,10 +473,17 @@ FC_REFLECT_ENUM( graphene::net::core_message_type_enum,
                  (check_firewall_reply_message_type)
                  (get_current_connections_request_message_type)
                  (get_current_connections_reply_message_type)
+                 (compact_block_message_type)
+                 (fetch_compact_block_transactions_message_type)
+                 (compact_block_transactions_message_type)
                  (core_message_type_last) )
 
 FC_REFLECT( graphene::net::trx_message, (trx) )
 FC_REFLECT( graphene::net::block_message, (block)(block_id) )
+FC_REFLECT( graphene::net::compact_block_transaction, (id)(operation_results) )
+FC_REFLECT( graphene::net::compact_block_message, (block_message_hash)(block_id)(header)(transactions) )
+FC_REFLECT( graphene::net::fetch_compact_block_transactions_message, (block_message_hash)(indexes) )
+FC_REFLECT( graphene::net::compact_block_transactions_message, (block_message_hash)(transactions) )
 
 FC_REFLECT( graphene::net::item_id, (item_type)
                                (item_hash) )
@@ -207,6 +207,7 @@ namespace graphene { namespace net
       fc::optional<fc::time_point_sec> fc_git_revision_unix_timestamp;
       fc::optional<std::string> platform;
       fc::optional<uint32_t> bitness;
+      bool             supports_compact_blocks; /// peer announced it understands compact_block_message
 
       // for inbound connections, these fields record what the peer sent us in
       // its hello message.  For outbound, they record what we sent the peer
@@ -253,6 +254,16 @@ namespace graphene { namespace net
       timestamped_items_set_type inventory_advertised_to_peer;
 
       item_to_time_map_type items_requested_from_peer;  /// items we've requested from this peer during normal operation.  fetch from another peer if this peer disconnects
+
+      /// a compact block from this peer waiting for the transactions we were missing
+      struct pending_compact_block
+      {
+        compact_block_message                          compact;
+        std::vector<fc::optional<signed_transaction>>  transactions;
+        std::vector<uint32_t>                          missing;
+        bool                                           all_from_peer = false;
+      };
+      fc::optional<pending_compact_block> compact_block_being_completed;
       /// @}
 
       // if they're flooding us with transactions, we set this to avoid fetching for a few seconds to let the
@@ -176,6 +176,7 @@ namespace graphene { namespace net {
       void cache_message( const message& message_to_cache, const message_hash_type& hash_of_message_to_cache,
                         const message_propagation_data& propagation_data, const fc::uint160_t& message_content_hash );
       message get_message( const message_hash_type& hash_of_message_to_lookup );
+      fc::optional<signed_transaction> find_transaction( const transaction_id_type& transaction_id ) const;
       message_propagation_data get_message_propagation_data( const fc::uint160_t& hash_of_message_contents_to_lookup ) const;
       size_t size() const { return _message_cache.size(); }
     };
@@ -209,6 +210,15 @@ namespace graphene { namespace net {
       FC_THROW_EXCEPTION(  fc::key_not_found_exception, "Requested message not in cache" );
     }
 
+    fc::optional<signed_transaction> blockchain_tied_message_cache::find_transaction( const transaction_id_type& transaction_id ) const
+    {
+      auto range = _message_cache.get<message_contents_hash_index>().equal_range( transaction_id );
+      for( auto iter = range.first; iter != range.second; ++iter )
+        if( iter->message_body.msg_type == trx_message_type )
+          return iter->message_body.as<trx_message>().trx;
+      return fc::optional<signed_transaction>();
+    }
+
     message_propagation_data blockchain_tied_message_cache::get_message_propagation_data( const fc::uint160_t& hash_of_message_contents_to_lookup ) const
     {
       if( hash_of_message_contents_to_lookup != fc::uint160_t() )
@@ -528,6 +538,7 @@ namespace graphene { namespace net { namespace detail {
       std::vector<uint32_t> _hard_fork_block_numbers; /// list of all block numbers where there are hard forks
 
       blockchain_tied_message_cache _message_cache; /// cache message we have received and might be required to provide to other peers via inventory requests
+      fc::optional<compact_block_message> _last_compact_block; /// most peers ask for the same new block, only encode it once
 
       fc::rate_limiting_group _rate_limiter;
 
@@ -657,6 +668,17 @@ namespace graphene { namespace net { namespace detail {
       void on_closing_connection_message( peer_connection* originating_peer,
                                           const closing_connection_message& closing_connection_message_received );
 
+      void on_compact_block_message( peer_connection* originating_peer,
+                                     const compact_block_message& compact_block_message_received );
+
+      void on_fetch_compact_block_transactions_message( peer_connection* originating_peer,
+                                                        const fetch_compact_block_transactions_message& fetch_compact_block_transactions_message_received );
+
+      void on_compact_block_transactions_message( peer_connection* originating_peer,
+                                                  const compact_block_transactions_message& compact_block_transactions_message_received );
+
+      void finish_compact_block( peer_connection* originating_peer );
+
       void on_current_time_request_message( peer_connection* originating_peer,
                                             const current_time_request_message& current_time_request_message_received );
 
@@ -1790,6 +1812,15 @@ namespace graphene { namespace net { namespace detail {
       case core_message_type_enum::block_message_type:
         process_block_message(originating_peer, received_message, message_hash);
         break;
+      case core_message_type_enum::compact_block_message_type:
+        on_compact_block_message(originating_peer, received_message.as<compact_block_message>());
+        break;
+      case core_message_type_enum::fetch_compact_block_transactions_message_type:
+        on_fetch_compact_block_transactions_message(originating_peer, received_message.as<fetch_compact_block_transactions_message>());
+        break;
+      case core_message_type_enum::compact_block_transactions_message_type:
+        on_compact_block_transactions_message(originating_peer, received_message.as<compact_block_transactions_message>());
+        break;
       case core_message_type_enum::current_time_request_message_type:
         on_current_time_request_message(originating_peer, received_message.as<current_time_request_message>());
         break;
@@ -1842,6 +1873,7 @@ namespace graphene { namespace net { namespace detail {
       user_data["bitness"] = sizeof(void*) * 8;
 
       user_data["node_id"] = _node_id;
+      user_data["compact_blocks"] = true;
 
       item_hash_t head_block_id = _delegate->get_head_block_id();
       user_data["last_known_block_hash"] = head_block_id;
@@ -1873,6 +1905,9 @@ namespace graphene { namespace net { namespace detail {
         originating_peer->node_id = user_data["node_id"].as<node_id_t>();
       if (user_data.contains("last_known_fork_block_number"))
         originating_peer->last_known_fork_block_number = user_data["last_known_fork_block_number"].as<uint32_t>();
+      // both ends of a connection send hello, so this is learned for inbound and outbound peers alike
+      if (user_data.contains("compact_blocks"))
+        originating_peer->supports_compact_blocks = user_data["compact_blocks"].as_bool();
     }
 
     void node_impl::on_hello_message( peer_connection* originating_peer, const hello_message& hello_message_received )
@@ -2736,9 +2771,20 @@ namespace graphene { namespace net { namespace detail {
           dlog("received item request for item ${id} from peer ${endpoint}, returning the item from my message cache",
                ("endpoint", originating_peer->get_remote_endpoint())
                ("id", requested_message.id()));
-          reply_messages.push_back(requested_message);
           if (fetch_items_message_received.item_type == block_message_type)
+          {
             last_block_message_sent = requested_message;
+            // a block requested by message hash is a new block, not a sync block.  Peers usually hold
+            // most of its transactions already, so send those as ids only
+            if (originating_peer->supports_compact_blocks && requested_message.msg_type == block_message_type)
+            {
+              if (!_last_compact_block || _last_compact_block->block_message_hash != item_hash)
+                _last_compact_block = compact_block_message(requested_message.as<block_message>(), item_hash);
+              reply_messages.push_back(*_last_compact_block);
+              continue;
+            }
+          }
+          reply_messages.push_back(requested_message);
           continue;
         }
         catch (fc::key_not_found_exception&)
@@ -2768,7 +2814,7 @@ namespace graphene { namespace net { namespace detail {
       }
 
       // if we sent them a block, update our record of the last block they've seen accordingly
-      if (last_block_message_sent)
+      if (last_block_message_sent && last_block_message_sent->msg_type == block_message_type)
       {
         graphene::net::block_message block = last_block_message_sent->as<graphene::net::block_message>();
         originating_peer->last_block_delegate_has_seen = block.block_id;
@@ -2793,6 +2839,9 @@ namespace graphene { namespace net { namespace detail {
       {
         originating_peer->items_requested_from_peer.erase( regular_item_iter );
         originating_peer->inventory_peer_advertised_to_us.erase( requested_item );
+        if (originating_peer->compact_block_being_completed &&
+            originating_peer->compact_block_being_completed->compact.block_message_hash == requested_item.item_hash)
+          originating_peer->compact_block_being_completed.reset();
         if (is_item_in_any_peers_inventory(requested_item))
           _items_to_fetch.insert(prioritized_item_id(requested_item, _items_to_fetch_sequence_counter++));
         wlog("Peer doesn't have the requested item.");
@@ -3513,6 +3562,138 @@ namespace graphene { namespace net { namespace detail {
       disconnect_from_peer(originating_peer, "You sent me a block that I didn't ask for", true, detailed_error);
     }
 
+    void node_impl::on_compact_block_message(peer_connection* originating_peer,
+                                             const compact_block_message& compact_block_message_received)
+    {
+      VERIFY_CORRECT_THREAD();
+      item_id block_item(block_message_type, compact_block_message_received.block_message_hash);
+      if (originating_peer->items_requested_from_peer.find(block_item) == originating_peer->items_requested_from_peer.end())
+      {
+        wlog("received a compact block ${block_id} I didn't ask for from peer ${endpoint}, disconnecting from peer",
+             ("endpoint", originating_peer->get_remote_endpoint())
+             ("block_id", compact_block_message_received.block_id));
+        fc::exception detailed_error(FC_LOG_MESSAGE(error, "You sent me a block that I didn't ask for, block_id: ${block_id}",
+                                                    ("block_id", compact_block_message_received.block_id)));
+        disconnect_from_peer(originating_peer, "You sent me a block that I didn't ask for", true, detailed_error);
+        return;
+      }
+
+      peer_connection::pending_compact_block pending;
+      pending.compact = compact_block_message_received;
+      pending.transactions.reserve(compact_block_message_received.transactions.size());
+      for (uint32_t i = 0; i < compact_block_message_received.transactions.size(); ++i)
+      {
+        pending.transactions.push_back(_message_cache.find_transaction(compact_block_message_received.transactions[i].id));
+        if (!pending.transactions.back())
+          pending.missing.push_back(i);
+      }
+      dlog("received compact block ${block_id} with ${n} transactions from peer ${endpoint}, ${missing} of them unknown",
+           ("block_id", compact_block_message_received.block_id)
+           ("n", compact_block_message_received.transactions.size())
+           ("missing", pending.missing.size())
+           ("endpoint", originating_peer->get_remote_endpoint()));
+
+      originating_peer->compact_block_being_completed = std::move(pending);
+      if (originating_peer->compact_block_being_completed->missing.empty())
+        finish_compact_block(originating_peer);
+      else
+        originating_peer->send_message(fetch_compact_block_transactions_message(compact_block_message_received.block_message_hash,
+                                                                                originating_peer->compact_block_being_completed->missing));
+    }
+
+    void node_impl::on_fetch_compact_block_transactions_message(peer_connection* originating_peer,
+                                                                const fetch_compact_block_transactions_message& fetch_compact_block_transactions_message_received)
+    {
+      VERIFY_CORRECT_THREAD();
+      const item_hash_t& block_message_hash = fetch_compact_block_transactions_message_received.block_message_hash;
+      try
+      {
+        block_message requested_block = _message_cache.get_message(block_message_hash).as<block_message>();
+        compact_block_transactions_message reply;
+        reply.block_message_hash = block_message_hash;
+        reply.transactions.reserve(fetch_compact_block_transactions_message_received.indexes.size());
+        for (uint32_t index : fetch_compact_block_transactions_message_received.indexes)
+        {
+          FC_ASSERT(index < requested_block.block.transactions.size());
+          reply.transactions.push_back(requested_block.block.transactions[index]);
+        }
+        originating_peer->send_message(reply);
+      }
+      catch (const fc::key_not_found_exception&)
+      {
+        // the block has left our cache, the peer will fall back to fetching it elsewhere
+        originating_peer->send_message(item_not_available_message(item_id(block_message_type, block_message_hash)));
+      }
+    }
+
+    void node_impl::on_compact_block_transactions_message(peer_connection* originating_peer,
+                                                          const compact_block_transactions_message& compact_block_transactions_message_received)
+    {
+      VERIFY_CORRECT_THREAD();
+      auto& pending = originating_peer->compact_block_being_completed;
+      if (!pending ||
+          pending->compact.block_message_hash != compact_block_transactions_message_received.block_message_hash ||
+          pending->missing.size() != compact_block_transactions_message_received.transactions.size())
+      {
+        wlog("received compact block transactions I didn't ask for from peer ${endpoint}", ("endpoint", originating_peer->get_remote_endpoint()));
+        fc::exception detailed_error(FC_LOG_MESSAGE(error, "You sent me compact block transactions that I didn't ask for"));
+        disconnect_from_peer(originating_peer, "You sent me compact block transactions that I didn't ask for", true, detailed_error);
+        return;
+      }
+      for (size_t i = 0; i < pending->missing.size(); ++i)
+        pending->transactions[pending->missing[i]] = compact_block_transactions_message_received.transactions[i];
+      pending->missing.clear();
+      finish_compact_block(originating_peer);
+    }
+
+    void node_impl::finish_compact_block(peer_connection* originating_peer)
+    {
+      VERIFY_CORRECT_THREAD();
+      peer_connection::pending_compact_block pending = std::move(*originating_peer->compact_block_being_completed);
+      originating_peer->compact_block_being_completed.reset();
+
+      graphene::net::block_message rebuilt;
+      rebuilt.block_id = pending.compact.block_id;
+      static_cast<graphene::chain::signed_block_header&>(rebuilt.block) = pending.compact.header;
+      rebuilt.block.transactions.reserve(pending.transactions.size());
+      for (size_t i = 0; i < pending.transactions.size(); ++i)
+      {
+        rebuilt.block.transactions.emplace_back(std::move(*pending.transactions[i]));
+        rebuilt.block.transactions.back().operation_results = std::move(pending.compact.transactions[i].operation_results);
+      }
+
+      // the message hash covers every transaction and result, so a match means we rebuilt exactly the block the peer has
+      message rebuilt_message(rebuilt);
+      message_hash_type rebuilt_hash = rebuilt_message.id();
+      if (rebuilt_hash != pending.compact.block_message_hash && !pending.all_from_peer)
+      {
+        // a transaction id does not cover the signatures, so the copy we hold may be signed differently
+        // from the one in the block.  Ask the peer for every transaction before giving up on it
+        dlog("compact block ${block_id} from peer ${endpoint} did not rebuild from our transactions, fetching all of them",
+             ("block_id", pending.compact.block_id)
+             ("endpoint", originating_peer->get_remote_endpoint()));
+        pending.missing.resize(pending.transactions.size());
+        for (uint32_t i = 0; i < pending.missing.size(); ++i)
+          pending.missing[i] = i;
+        pending.all_from_peer = true;
+        originating_peer->compact_block_being_completed = std::move(pending);
+        originating_peer->send_message(fetch_compact_block_transactions_message(originating_peer->compact_block_being_completed->compact.block_message_hash,
+                                                                                originating_peer->compact_block_being_completed->missing));
+        return;
+      }
+      if (rebuilt_hash != pending.compact.block_message_hash)
+      {
+        wlog("compact block ${block_id} from peer ${endpoint} did not rebuild to the block it announced",
+             ("block_id", pending.compact.block_id)
+             ("endpoint", originating_peer->get_remote_endpoint()));
+        fc::exception detailed_error(FC_LOG_MESSAGE(error, "Your compact block ${block_id} does not match its block",
+                                                    ("block_id", pending.compact.block_id)));
+        disconnect_from_peer(originating_peer, "You sent me an invalid compact block", true, detailed_error);
+        return;
+      }
+      process_block_message(originating_peer, rebuilt_message, rebuilt_hash);
+    }
+
     void node_impl::on_current_time_request_message(peer_connection* originating_peer,
                                                     const current_time_request_message& current_time_request_message_received)
     {
@@ -4160,6 +4341,8 @@ namespace graphene { namespace net { namespace detail {
     {
       VERIFY_CORRECT_THREAD();
       new_peer->accept_connection(); // this blocks until the secure connection is fully negotiated
+      // the accepting side says hello too, so the peer that connected to us learns our user_data
+      // (including "compact_blocks") just as we learn theirs
       send_hello_message(new_peer);
     }
 
@@ -4806,6 +4989,7 @@ namespace graphene { namespace net { namespace detail {
         peer_details["startingheight"] = "";
         peer_details["banscore"] = "";
         peer_details["syncnode"] = "";
+        peer_details["compact_blocks"] = peer->supports_compact_blocks;
 
         if (peer->fc_git_revision_sha)
         {
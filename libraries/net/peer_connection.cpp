@@ -80,6 +80,7 @@ namespace graphene { namespace net
       their_state(their_connection_state::disconnected),
       we_have_requested_close(false),
       negotiation_status(connection_negotiation_status::disconnected),
+      supports_compact_blocks(false),
       number_of_unfetched_item_ids(0),
       peer_needs_sync_items_from_us(true),
       we_need_sync_items_from_peer(true),
@@ -28,6 +28,7 @@
 #include <graphene/monitor/coin_object_monitor.hpp>
 #include <graphene/monitor/witness_monitor.hpp>
 
+#include <graphene/chain/coin_object.hpp>
 #include <graphene/chain/config.hpp>
 #include <graphene/chain/database.hpp>
 
@@ -174,10 +175,10 @@ void monitor_plugin::plugin_startup()
 void monitor_plugin::monitor_block( const signed_block& b )
 {
     auto head = database().head_block_num();
-    ilog("monitor block: head block num: ${head}, new block: ${block}", ("head", head)("block", b));
+    tlog("monitor block: head block num: ${head}, new block: ${block}", ("head", head)("block", b));
     //统计每个块的交易数
     block_trans_count[head] = b.transactions.size();
-    ilog("block num: ${block_num}, trans count: ${trans_count}", ("block_num", head)("trans_count",b.transactions.size()));
+    tlog("block num: ${block_num}, trans count: ${trans_count}", ("block_num", head)("trans_count",b.transactions.size()));
 
     for( const auto& trx : b.transactions )
     {
@@ -194,6 +195,28 @@ void monitor_plugin::monitor_block( const signed_block& b )
 
 void monitor_plugin::monitor_operation(const operation& op)
 {
+    // a batch feed is accounted as one coin_feed_price_operation per coin, so feeder stats see both paths
+    if (op.which() == operation::tag<coin_feed_price_batch_operation>::value)
+    {
+        const auto& batch = op.get<coin_feed_price_batch_operation>();
+        for (const auto& feed : batch.feeds)
+        {
+            const coin_object* coin = database().find(feed.coin_id);
+            if (coin == nullptr)
+                continue;
+            auto pos = coin->platform_quote_base.find(':');
+            coin_feed_price_operation single;
+            single.publisher   = batch.publisher;
+            single.coin_id     = feed.coin_id;
+            single.platform_id = coin->platform_quote_base.substr(0, pos);
+            single.quote_base  = coin->platform_quote_base.substr(pos + 1);
+            single.prices      = feed.prices;
+            single.reset_price = feed.reset_price;
+            monitor_operation(single);
+        }
+        return;
+    }
+
     int i_which = op.which();
     uint32_t u_which = uint32_t( i_which );
     if( i_which < 0 )
@@ -1442,6 +1442,18 @@ class wallet_api
        */
       signed_transaction sign_transaction(signed_transaction tx, bool broadcast = false);
 
+      /** Signs several transactions against one reference block.
+       *
+       * Like sign_transaction(), but the approving accounts of all transactions are fetched together and every
+       * transaction references the same head block.  When broadcasting, all transactions are sent before the
+       * wallet waits for the replies.
+       *
+       * @param txs the transactions to sign
+       * @param broadcast true if you wish to broadcast the transactions
+       * @return the signed transactions, in the order given
+       */
+      vector<signed_transaction> sign_transactions(vector<signed_transaction> txs, bool broadcast = false);
+
       /** Returns an uninitialized object representing a given blockchain operation.
        *
        * This returns a default-initialized object of the given type; it can be used 
@@ -1547,6 +1559,20 @@ class wallet_api
           bool broadcast = false
 		  );
 
+      /** Feed the prices of several coins in one operation.
+       *
+       * @param feeder_account the feeder publishing and paying for the prices
+       * @param prices prices by coin, keyed by "platform_id:quote_base" (e.g. "1000001:BTC/USD") or coin id, each
+       *        a map of <time in second, price>
+       * @param broadcast true if you wish to broadcast the transaction
+       * @return the signed version of the transaction
+       */
+      signed_transaction feed_coin_price_batch(
+          const string& feeder_account,
+          const map<string, map<uint32_t, share_type>>& prices,
+          bool broadcast = false
+      );
+
       /** reset coin price.
        *
        * @param fee_paying_account The account paying the fee for the op.
@@ -1884,6 +1910,7 @@ FC_API( graphene::wallet::wallet_api,
         (save_wallet_file)
         (serialize_transaction)
         (sign_transaction)
+        (sign_transactions)
         (get_prototype_operation)
         (propose_parameter_change)
         (propose_fee_change)
@@ -1943,6 +1970,7 @@ FC_API( graphene::wallet::wallet_api,
 		(get_buy_list)
 		//[end]
         (feed_coin_price)
+        (feed_coin_price_batch)
         (reset_coin_price)
         (get_coin_price)
         (get_latest_valid_price)
@@ -409,6 +409,10 @@ public:
       {
          on_block_applied( block_id );
       } );
+      _remote_db->set_subscribe_callback( [this](const variant& updates )
+      {
+         on_object_updates( updates );
+      }, false );
 
       _wallet.chain_id = _chain_id;
       _wallet.ws_server = initial_data.ws_server;
@@ -601,6 +605,11 @@ public:
    }
    account_id_type get_account_id(string account_name_or_id) const
    {
+      // ids of our own accounts are known, the operation builders call this for every signer
+      auto& by_name_idx = _wallet.my_accounts.get<by_name>();
+      auto local = by_name_idx.find(account_name_or_id);
+      if( local != by_name_idx.end() )
+         return local->get_id();
       return get_account(account_name_or_id).get_id();
    }
    optional<asset_object> find_asset(asset_id_type id)const
@@ -694,10 +703,7 @@ public:
 
    fc::ecc::private_key              get_private_key(const public_key_type& id)const
    {
-      auto it = _keys.find(id);
-      FC_ASSERT( it != _keys.end() );
-
-      fc::optional< fc::ecc::private_key > privkey = wif_to_key( it->second );
+      const fc::ecc::private_key* privkey = find_private_key( id );
       FC_ASSERT( privkey );
       return *privkey;
    }
@@ -913,7 +919,7 @@ public:
       if( review_period_seconds )
          op.review_period_seconds = review_period_seconds;
       trx.operations = {op};
-      _remote_db->get_global_properties().parameters.current_fees->set_fee( trx.operations.front() );
+      get_current_fees()->set_fee( trx.operations.front() );
 
       return trx = sign_transaction(trx, broadcast);
    }
@@ -934,7 +940,7 @@ public:
       if( review_period_seconds )
          op.review_period_seconds = review_period_seconds;
       trx.operations = {op};
-      _remote_db->get_global_properties().parameters.current_fees->set_fee( trx.operations.front() );
+      get_current_fees()->set_fee( trx.operations.front() );
 
       return trx = sign_transaction(trx, broadcast);
    }
@@ -984,7 +990,7 @@ public:
 
       tx.operations.push_back( account_create_op );
 
-      auto current_fees = _remote_db->get_global_properties().parameters.current_fees;
+      auto current_fees = get_current_fees();
       set_operation_fees( tx, current_fees );
 
       vector<public_key_type> paying_keys = registrar_account_object.active.get_keys();
@@ -1025,7 +1031,7 @@ public:
       op.account_to_upgrade = account_obj.get_id();
       op.upgrade_to_lifetime_member = true;
       tx.operations = {op};
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1043,7 +1049,7 @@ public:
       op.account_id = account_obj.get_id();
       op.homepage = homepage;
       tx.operations = {op};
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1128,7 +1134,7 @@ public:
 
          tx.operations.push_back( account_create_op );
 
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+         set_operation_fees( tx, get_current_fees());
 
          vector<public_key_type> paying_keys = registrar_account_object.active.get_keys();
 
@@ -1193,7 +1199,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( create_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1242,7 +1248,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( publish_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
      
       result.create_fee = tx.operations[0].get<subject_publish_operation>().fee;
 */
@@ -1279,7 +1285,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( publish_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1303,7 +1309,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( vote_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1330,7 +1336,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( event_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1361,7 +1367,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1382,7 +1388,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1406,7 +1412,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1428,7 +1434,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( publish_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1459,7 +1465,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( feed_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
       ilog("coin_feed_price_operation: ${op}", ("op", feed_op));
 
@@ -1478,6 +1484,44 @@ public:
       //return feed_coin_price_imp(feeder_account, platform_id, prices, false, broadcast);
    }
 
+   signed_transaction feed_coin_price_batch(
+      const string& feeder_account,
+      const map<string, map<uint32_t, share_type>>& prices, //<"platform_id:quote_base", <time, price>>
+      bool broadcast
+      )
+   { try {
+      FC_ASSERT( !prices.empty(), "No prices to feed" );
+      vector<string> names;
+      names.reserve( prices.size() );
+      for( const auto& item : prices )
+         names.push_back( item.first );
+      vector<optional<coin_object>> coins = _remote_db->lookup_coin_names( names );
+
+      coin_feed_price_batch_operation feed_op;
+      feed_op.publisher = get_account_id( feeder_account );
+      auto price_itr = prices.begin();
+      for( size_t i = 0; i < coins.size(); ++i, ++price_itr )
+      {
+         if( !coins[i] )
+            FC_THROW( "No coin named ${name} exists!", ("name", names[i]) );
+         coin_feed_price_batch_operation::coin_feed feed;
+         feed.coin_id = coins[i]->id;
+         feed.prices = price_itr->second;
+         feed_op.feeds.push_back( std::move( feed ) );
+      }
+      std::sort( feed_op.feeds.begin(), feed_op.feeds.end(),
+                 []( const coin_feed_price_batch_operation::coin_feed& a, const coin_feed_price_batch_operation::coin_feed& b ) {
+                    return a.coin_id < b.coin_id;
+                 });
+
+      signed_transaction tx;
+      tx.operations.push_back( feed_op );
+      set_operation_fees( tx, get_current_fees());
+      tx.validate();
+
+      return sign_transaction( tx, broadcast );
+   } FC_CAPTURE_AND_RETHROW( (feeder_account)(prices)(broadcast) ) }
+
    signed_transaction reset_coin_price(
       const string& feeder_account,
       const string& platform_id, //e.g. "1000001"
@@ -1603,7 +1647,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( fund_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1625,7 +1669,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( reserve_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1646,7 +1690,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( settle_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1667,7 +1711,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( settle_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1685,7 +1729,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( whitelist_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1703,7 +1747,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( committee_member_create_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1799,7 +1843,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( witness_create_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       _wallet.pending_witness_registrations[owner_account] = key_to_wif(witness_private_key);
@@ -1826,7 +1870,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( witness_update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1877,7 +1921,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -1942,7 +1986,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2000,7 +2044,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( vesting_balance_withdraw_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2035,7 +2079,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( account_update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2069,7 +2113,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( account_update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2100,7 +2144,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( account_update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2126,74 +2170,96 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( account_update_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
    } FC_CAPTURE_AND_RETHROW( (account_to_modify)(desired_number_of_witnesses)(desired_number_of_committee_members)(broadcast) ) }
 
-   signed_transaction sign_transaction(signed_transaction tx, bool broadcast = false)
+   /**
+    * Fetches the accounts of ids that are not in _account_cache yet, or were not updated for a while, with one
+    * remote call.  The server caps the objects a connection may subscribe to, past it an account we cache gets no
+    * updates, so entries are not trusted forever.
+    */
+   void cache_accounts( const vector<account_id_type>& ids )
+   {
+      const fc::time_point stale = fc::time_point::now() - fc::seconds(60);
+      vector<account_id_type> missing;
+      for( const auto& id : ids )
+      {
+         auto it = _account_cache.find( id );
+         if( it == _account_cache.end() || it->second.updated < stale )
+            missing.push_back( id );
+      }
+      if( missing.empty() )
+         return;
+
+      // get_accounts() subscribes us to the accounts, on_object_updates() keeps them current
+      vector< optional<account_object> > accounts = _remote_db->get_accounts( missing );
+      FC_ASSERT( accounts.size() == missing.size() );
+      for( size_t i = 0; i < accounts.size(); ++i )
+      {
+         if( !accounts[i].valid() )
+         {
+            wlog( "operation_get_required_auths said approval of non-existing account ${id} was needed",
+                  ("id", missing[i]) );
+            continue;
+         }
+         _account_cache[ missing[i] ] = { std::move( *accounts[i] ), fc::time_point::now() };
+      }
+   }
+
+   /// Drops the approvers of tx from _account_cache, so the next signature fetches their authorities again
+   void forget_approvers( const signed_transaction& tx )
    {
       flat_set<account_id_type> req_active_approvals;
       flat_set<account_id_type> req_owner_approvals;
       vector<authority>         other_auths;
+      get_required_approvals( tx, req_active_approvals, req_owner_approvals, other_auths );
+      for( const auto& id : req_active_approvals )
+         _account_cache.erase( id );
+      for( const auto& id : req_owner_approvals )
+         _account_cache.erase( id );
+   }
 
+   void get_required_approvals( const signed_transaction& tx,
+                                flat_set<account_id_type>& req_active_approvals,
+                                flat_set<account_id_type>& req_owner_approvals,
+                                vector<authority>& other_auths )const
+   {
       tx.get_required_authorities( req_active_approvals, req_owner_approvals, other_auths );
 
       for( const auto& auth : other_auths )
          for( const auto& a : auth.account_auths )
             req_active_approvals.insert(a.first);
+   }
 
-      // std::merge lets us de-duplicate account_id's that occur in both
-      //   sets, and dump them into a vector (as required by remote_db api)
-      //   at the same time
-      vector<account_id_type> v_approving_account_ids;
-      std::merge(req_active_approvals.begin(), req_active_approvals.end(),
-                 req_owner_approvals.begin() , req_owner_approvals.end(),
-                 std::back_inserter(v_approving_account_ids));
-
-      /// TODO: fetch the accounts specified via other_auths as well.
-
-      vector< optional<account_object> > approving_account_objects =
-            _remote_db->get_accounts( v_approving_account_ids );
+   /// Keys of the accounts and authorities that must approve tx, the accounts must be in _account_cache
+   flat_set<public_key_type> get_approving_keys( const signed_transaction& tx )const
+   {
+      flat_set<account_id_type> req_active_approvals;
+      flat_set<account_id_type> req_owner_approvals;
+      vector<authority>         other_auths;
+      get_required_approvals( tx, req_active_approvals, req_owner_approvals, other_auths );
 
       /// TODO: recursively check one layer deeper in the authority tree for keys
 
-      FC_ASSERT( approving_account_objects.size() == v_approving_account_ids.size() );
-
-      flat_map<account_id_type, account_object*> approving_account_lut;
-      size_t i = 0;
-      for( optional<account_object>& approving_acct : approving_account_objects )
-      {
-         if( !approving_acct.valid() )
-         {
-            wlog( "operation_get_required_auths said approval of non-existing account ${id} was needed",
-                  ("id", v_approving_account_ids[i]) );
-            i++;
-            continue;
-         }
-         approving_account_lut[ approving_acct->id ] = &(*approving_acct);
-         i++;
-      }
-
       flat_set<public_key_type> approving_key_set;
       for( account_id_type& acct_id : req_active_approvals )
       {
-         const auto it = approving_account_lut.find( acct_id );
-         if( it == approving_account_lut.end() )
+         const auto it = _account_cache.find( acct_id );
+         if( it == _account_cache.end() )
             continue;
-         const account_object* acct = it->second;
-         vector<public_key_type> v_approving_keys = acct->active.get_keys();
+         vector<public_key_type> v_approving_keys = it->second.account.active.get_keys();
          for( const public_key_type& approving_key : v_approving_keys )
             approving_key_set.insert( approving_key );
       }
       for( account_id_type& acct_id : req_owner_approvals )
       {
-         const auto it = approving_account_lut.find( acct_id );
-         if( it == approving_account_lut.end() )
+         const auto it = _account_cache.find( acct_id );
+         if( it == _account_cache.end() )
             continue;
-         const account_object* acct = it->second;
-         vector<public_key_type> v_approving_keys = acct->owner.get_keys();
+         vector<public_key_type> v_approving_keys = it->second.account.owner.get_keys();
          for( const public_key_type& approving_key : v_approving_keys )
             approving_key_set.insert( approving_key );
       }
@@ -2202,8 +2268,93 @@ public:
          for( const auto& k : a.key_auths )
             approving_key_set.insert( k.first );
       }
+      return approving_key_set;
+   }
 
-      auto dyn_props = get_dynamic_global_properties();
+   /**
+    * Head block and time to build transactions against.  Kept current by on_object_updates(), fetched again
+    * if no update arrived for a while in case the server does not notify us.
+    */
+   const dynamic_global_property_object& get_reference_properties()
+   {
+      if( !_dynamic_props_cache.valid() || fc::time_point::now() - _dynamic_props_updated > fc::seconds(10) )
+      {
+         // get_objects() subscribes us to the object
+         fc::variants objs = _remote_db->get_objects( { dynamic_global_property_id_type() } );
+         FC_ASSERT( objs.size() == 1 && !objs[0].is_null() );
+         _dynamic_props_cache = objs[0].as<dynamic_global_property_object>();
+         _dynamic_props_updated = fc::time_point::now();
+      }
+      return *_dynamic_props_cache;
+   }
+
+   /// Fee schedule to set operation fees with, cached like get_reference_properties()
+   const smart_ref<fee_schedule>& get_current_fees()const
+   {
+      if( !_global_props_cache.valid() || fc::time_point::now() - _global_props_updated > fc::seconds(10) )
+      {
+         // get_objects() subscribes us to the object
+         fc::variants objs = _remote_db->get_objects( { global_property_id_type() } );
+         FC_ASSERT( objs.size() == 1 && !objs[0].is_null() );
+         _global_props_cache = objs[0].as<global_property_object>();
+         _global_props_updated = fc::time_point::now();
+      }
+      return _global_props_cache->parameters.current_fees;
+   }
+
+   /// Called by the remote database with the objects we are subscribed to every time some of them change
+   void on_object_updates( const variant& updates )
+   {
+      if( !updates.is_array() )
+         return;
+      for( const variant& update : updates.get_array() )
+      {
+         if( update.is_object() )
+         {
+            object_id_type id = update.get_object()["id"].as<object_id_type>();
+            if( id.is<account_id_type>() )
+            {
+               auto it = _account_cache.find( account_id_type( id ) );
+               if( it != _account_cache.end() )
+                  it->second = { update.as<account_object>(), fc::time_point::now() };
+            }
+            else if( id == dynamic_global_property_id_type() )
+            {
+               _dynamic_props_cache = update.as<dynamic_global_property_object>();
+               _dynamic_props_updated = fc::time_point::now();
+            }
+            else if( id == global_property_id_type() )
+            {
+               _global_props_cache = update.as<global_property_object>();
+               _global_props_updated = fc::time_point::now();
+            }
+         }
+         else if( update.is_string() )
+         {
+            object_id_type id = update.as<object_id_type>();
+            if( id.is<account_id_type>() )
+               _account_cache.erase( account_id_type( id ) );
+         }
+      }
+   }
+
+   /// Private key of pub decoded once while the wallet is unlocked, null if it is not in this wallet
+   const fc::ecc::private_key* find_private_key( const public_key_type& pub )const
+   {
+      auto cached = _decoded_keys.find( pub );
+      if( cached != _decoded_keys.end() )
+         return &cached->second;
+      auto it = _keys.find( pub );
+      if( it == _keys.end() )
+         return nullptr;
+      fc::optional<fc::ecc::private_key> privkey = wif_to_key( it->second );
+      FC_ASSERT( privkey.valid(), "Malformed private key in _keys" );
+      return &( _decoded_keys[pub] = *privkey );
+   }
+
+   void sign_with_reference( signed_transaction& tx, const flat_set<public_key_type>& approving_key_set,
+                             const dynamic_global_property_object& dyn_props )
+   {
       tx.set_reference_block( dyn_props.head_block_id );
 
       // first, some bookkeeping, expire old items from _recently_generated_transactions
@@ -2221,15 +2372,10 @@ public:
          tx.set_expiration( dyn_props.time + fc::seconds(30 + expiration_time_offset) );
          tx.signatures.clear();
 
-         for( public_key_type& key : approving_key_set )
+         for( const public_key_type& key : approving_key_set )
          {
-            auto it = _keys.find(key);
-            if( it != _keys.end() )
-            {
-               fc::optional<fc::ecc::private_key> privkey = wif_to_key( it->second );
-               FC_ASSERT( privkey.valid(), "Malformed private key in _keys" );
+            if( const fc::ecc::private_key* privkey = find_private_key( key ) )
                tx.sign( *privkey, _chain_id );
-            }
             /// TODO: if transaction has enough signatures to be "valid" don't add any more,
             /// there are cases where the wallet may have more keys than strictly necessary and
             /// the transaction will be rejected if the transaction validates without requiring
@@ -2251,21 +2397,65 @@ public:
          // else we've generated a dupe, increment expiration time and re-sign it
          ++expiration_time_offset;
       }
+   }
+
+   signed_transaction sign_transaction(signed_transaction tx, bool broadcast = false)
+   {
+      return sign_transactions( { std::move(tx) }, broadcast ).front();
+   }
+
+   /**
+    * Signs every transaction against the same reference block, fetching the approving accounts not cached
+    * yet with one call.  The broadcasts are all sent before waiting for any of them.
+    */
+   vector<signed_transaction> sign_transactions( vector<signed_transaction> txs, bool broadcast = false )
+   {
+      vector<account_id_type> approvers;
+      for( const auto& tx : txs )
+      {
+         flat_set<account_id_type> req_active_approvals;
+         flat_set<account_id_type> req_owner_approvals;
+         vector<authority>         other_auths;
+         get_required_approvals( tx, req_active_approvals, req_owner_approvals, other_auths );
+         approvers.insert( approvers.end(), req_active_approvals.begin(), req_active_approvals.end() );
+         approvers.insert( approvers.end(), req_owner_approvals.begin(), req_owner_approvals.end() );
+      }
+      std::sort( approvers.begin(), approvers.end() );
+      approvers.erase( std::unique( approvers.begin(), approvers.end() ), approvers.end() );
+      cache_accounts( approvers );
+
+      dynamic_global_property_object dyn_props = get_reference_properties();
+      for( auto& tx : txs )
+         sign_with_reference( tx, get_approving_keys( tx ), dyn_props );
 
       if( broadcast )
       {
-         try
+         vector< fc::future<void> > broadcasts;
+         broadcasts.reserve( txs.size() );
+         for( const auto& tx : txs )
+            broadcasts.push_back( fc::async( [this, &tx]() { _remote_net_broadcast->broadcast_transaction( tx ); },
+                                             "broadcast_transaction" ) );
+         optional<fc::exception> failure;
+         for( size_t i = 0; i < txs.size(); ++i )
          {
-            _remote_net_broadcast->broadcast_transaction( tx );
-         }
-         catch (const fc::exception& e)
-         {
-            elog("Caught exception while broadcasting tx ${id}:  ${e}", ("id", tx.id().str())("e", e.to_detail_string()) );
-            throw;
+            try
+            {
+               broadcasts[i].wait();
+            }
+            catch (const fc::exception& e)
+            {
+               elog("Caught exception while broadcasting tx ${id}:  ${e}", ("id", txs[i].id().str())("e", e.to_detail_string()) );
+               // the error code does not survive the RPC, so any failure may be an authority we have not seen change
+               forget_approvers( txs[i] );
+               if( !failure )
+                  failure = e;
+            }
          }
+         if( failure )
+            failure->dynamic_rethrow_exception();
       }
 
-      return tx;
+      return txs;
    }
 
    signed_transaction sell_asset(string seller_account,
@@ -2289,7 +2479,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back(op);
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2310,7 +2500,7 @@ public:
 
       signed_transaction trx;
       trx.operations = {op};
-      set_operation_fees( trx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( trx, get_current_fees());
       trx.validate();
       idump((broadcast));
 
@@ -2327,7 +2517,7 @@ public:
          op.fee_paying_account = get_object<limit_order_object>(order_id).seller;
          op.order = order_id;
          trx.operations = {op};
-         set_operation_fees( trx, _remote_db->get_global_properties().parameters.current_fees);
+         set_operation_fees( trx, get_current_fees());
 
          trx.validate();
          return sign_transaction(trx, broadcast);
@@ -2362,7 +2552,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back(xfer_op);
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction(tx, broadcast);
@@ -2392,7 +2582,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back(issue_op);
-      set_operation_fees(tx,_remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees(tx,get_current_fees());
       tx.validate();
 
       return sign_transaction(tx, broadcast);
@@ -2946,7 +3136,7 @@ public:
 
       signed_transaction tx;
       tx.operations.push_back( op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+      set_operation_fees( tx, get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -2972,7 +3162,7 @@ public:
 
          signed_transaction tx;
          tx.operations.push_back( op );
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+         set_operation_fees( tx, get_current_fees());
          tx.validate();
 
          return sign_transaction( tx, broadcast );
@@ -3011,7 +3201,7 @@ public:
 
          signed_transaction tx;
          tx.operations.push_back( prop_op );
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees);
+         set_operation_fees( tx, get_current_fees());
          tx.validate();
 
          return sign_transaction( tx, broadcast );
@@ -3051,6 +3241,19 @@ public:
 
    mutable map<asset_id_type, asset_object> _asset_cache;
    mutable map<coin_id_type, coin_object> _coin_cache;
+   struct cached_account
+   {
+      account_object account;
+      fc::time_point updated;
+   };
+   /// authorities of the accounts we signed for, updated through our subscription to them
+   map<account_id_type, cached_account> _account_cache;
+   optional<dynamic_global_property_object> _dynamic_props_cache;
+   fc::time_point                           _dynamic_props_updated;
+   mutable optional<global_property_object> _global_props_cache;
+   mutable fc::time_point                   _global_props_updated;
+   /// _keys decoded by find_private_key(), cleared when the wallet is locked
+   mutable map<public_key_type, fc::ecc::private_key> _decoded_keys;
 };
 
 std::string operation_printer::fee(const asset& a)const {
@@ -3737,6 +3940,15 @@ signed_transaction wallet_api::feed_coin_price(
    return my->feed_coin_price(feeder_account, platform_id, quote_base, prices, broadcast);
 }
 
+signed_transaction wallet_api::feed_coin_price_batch(
+   const string& feeder_account,
+   const map<string, map<uint32_t, share_type>>& prices,
+   bool broadcast
+   )
+{
+   return my->feed_coin_price_batch(feeder_account, prices, broadcast);
+}
+
 signed_transaction wallet_api::reset_coin_price(
    const string& feeder_account,
    const string& platform_id, //e.g. "1000001"
@@ -3994,6 +4206,11 @@ signed_transaction wallet_api::sign_transaction(signed_transaction tx, bool broa
    return my->sign_transaction( tx, broadcast);
 } FC_CAPTURE_AND_RETHROW( (tx) ) }
 
+vector<signed_transaction> wallet_api::sign_transactions(vector<signed_transaction> txs, bool broadcast /* = false */)
+{ try {
+   return my->sign_transactions( txs, broadcast );
+} FC_CAPTURE_AND_RETHROW( (txs) ) }
+
 operation wallet_api::get_prototype_operation(string operation_name)
 {
    return my->get_prototype_operation( operation_name );
@@ -4212,6 +4429,7 @@ void wallet_api::lock()
    for( auto key : my->_keys )
       key.second = key_to_wif(fc::ecc::private_key());
    my->_keys.clear();
+   my->_decoded_keys.clear();
    my->_checksum = fc::sha512();
    my->self.lock_changed(true);
 } FC_CAPTURE_AND_RETHROW() }
@@ -4339,7 +4557,7 @@ vector< signed_transaction > wallet_api_impl::import_balance( string name_or_id,
       tx.operations.reserve( ctx.ops.size() );
       for( const balance_claim_operation& op : ctx.ops )
          tx.operations.emplace_back( op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.current_fees );
+      set_operation_fees( tx, get_current_fees() );
       tx.validate();
       signed_transaction signed_tx = sign_transaction( tx, false );
       for( const address& addr : ctx.addrs )
@@ -4539,7 +4757,7 @@ blind_confirmation wallet_api::transfer_from_blind( string from_blind_account_ke
    transfer_from_blind_operation from_blind;
 
 
-   auto fees  = my->_remote_db->get_global_properties().parameters.current_fees;
+   auto fees  = my->get_current_fees();
    fc::optional<asset_object> asset_obj = get_asset(symbol);
    FC_ASSERT(asset_obj.valid(), "Could not find asset matching ${asset}", ("asset", symbol));
    auto amount = asset_obj->amount_from_string(amount_in);
@@ -4617,7 +4835,7 @@ blind_confirmation wallet_api::blind_transfer_help( string from_key_or_label,
    blind_transfer_operation blind_tr;
    blind_tr.outputs.resize(2);
 
-   auto fees  = my->_remote_db->get_global_properties().parameters.current_fees;
+   auto fees  = my->get_current_fees();
 
    auto amount = asset_obj->amount_from_string(amount_in);
 
@@ -4839,7 +5057,7 @@ blind_confirmation wallet_api::transfer_to_blind( string from_account_id_or_name
               [&]( const blind_output& a, const blind_output& b ){ return a.commitment < b.commitment; } );
 
    confirm.trx.operations.push_back( bop );
-   my->set_operation_fees( confirm.trx, my->_remote_db->get_global_properties().parameters.current_fees);
+   my->set_operation_fees( confirm.trx, my->get_current_fees());
    confirm.trx.validate();
    confirm.trx = sign_transaction(confirm.trx, broadcast);
 
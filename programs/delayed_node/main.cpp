@@ -204,7 +204,8 @@ void write_default_logging_config_to_stream(std::ostream& out)
           "# declare an appender named \"p2p\" that writes messages to p2p.log\n"
           "[log.file_appender.p2p]\n"
           "filename=logs/p2p/p2p.log\n"
-          "# filename can be absolute or relative to this config file\n\n"
+          "# filename can be absolute or relative to this config file\n"
+          "# async=true formats and writes messages on a background thread\n\n"
           "# route any messages logged to the default logger to the \"stderr\" logger we\n"
           "# declared above, if they are info level are higher\n"
           "[logger.default]\n"
@@ -271,6 +272,7 @@ fc::optional<fc::logging_config> load_logging_config_from_ini_file(const fc::pat
             file_appender_config.rotate = true;
             file_appender_config.rotation_interval = fc::hours(1);
             file_appender_config.rotation_limit = fc::days(1);
+            file_appender_config.async = section_tree.get<bool>("async", false);
             logging_config.appenders.push_back(fc::appender_config(file_appender_name, "file", fc::variant(file_appender_config)));
             found_logging_config = true;
          }
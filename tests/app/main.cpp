@@ -21,13 +21,17 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <graphene/app/api.hpp>
 #include <graphene/app/application.hpp>
 #include <graphene/app/plugin.hpp>
 
 #include <graphene/chain/balance_object.hpp>
 
+#include <graphene/utilities/key_conversion.hpp>
 #include <graphene/utilities/tempdir.hpp>
 
+#include <graphene/wallet/wallet.hpp>
+
 #include <graphene/account_history/account_history_plugin.hpp>
 
 #include <fc/thread/thread.hpp>
@@ -80,6 +84,13 @@ BOOST_AUTO_TEST_CASE( two_node_network )
       BOOST_CHECK_EQUAL(std::string(app1.p2p_node()->get_connected_peers().front().host.get_address()), "127.0.0.1");
       BOOST_TEST_MESSAGE( "app1 and app2 successfully connected" );
 
+      // app2 connected to app1, and each side learned that the other one takes compact blocks
+      BOOST_REQUIRE_EQUAL(app2.p2p_node()->get_connection_count(), 1);
+      BOOST_CHECK(app1.p2p_node()->get_connected_peers().front().info["inbound"].as_bool());
+      BOOST_CHECK(app1.p2p_node()->get_connected_peers().front().info["compact_blocks"].as_bool());
+      BOOST_CHECK(!app2.p2p_node()->get_connected_peers().front().info["inbound"].as_bool());
+      BOOST_CHECK(app2.p2p_node()->get_connected_peers().front().info["compact_blocks"].as_bool());
+
       std::shared_ptr<chain::database> db1 = app1.chain_database();
       std::shared_ptr<chain::database> db2 = app2.chain_database();
 
@@ -150,3 +161,97 @@ BOOST_AUTO_TEST_CASE( two_node_network )
       throw;
    }
 }
+
+BOOST_AUTO_TEST_CASE( wallet_sign_transactions )
+{
+   using namespace graphene::chain;
+   using namespace graphene::app;
+   try {
+      fc::temp_directory app_dir( graphene::utilities::temp_directory_path() );
+      fc::temp_directory wallet_dir( graphene::utilities::temp_directory_path() );
+
+      graphene::app::application app1;
+      boost::program_options::variables_map cfg;
+      cfg.emplace("p2p-endpoint", boost::program_options::variable_value(string("127.0.0.1:4141"), false));
+      app1.initialize(app_dir.path(), cfg);
+      app1.startup();
+      std::shared_ptr<chain::database> db1 = app1.chain_database();
+
+      fc::ecc::private_key nathan_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("nathan")));
+      fc::ecc::private_key nathan_new_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("nathan_new")));
+      account_id_type nathan_id = db1->get_index_type<account_index>().indices().get<by_name>().find( "nathan" )->id;
+      auto push_signed = [&]( signed_transaction trx ) {
+         for( auto& op : trx.operations )
+            db1->current_fee_schedule().set_fee( op );
+         trx.set_expiration( db1->get_slot_time( 10 ) );
+         trx.sign( nathan_key, db1->get_chain_id() );
+         db1->push_transaction( trx );
+      };
+      {
+         balance_claim_operation claim_op;
+         balance_id_type bid = balance_id_type();
+         claim_op.deposit_to_account = nathan_id;
+         claim_op.balance_to_claim = bid;
+         claim_op.balance_owner_key = nathan_key.get_public_key();
+         claim_op.total_claimed = bid(*db1).balance;
+         signed_transaction trx;
+         trx.operations.push_back( claim_op );
+         push_signed( trx );
+         db1->generate_block( db1->get_slot_time(1), db1->get_scheduled_witness(1), nathan_key, database::skip_nothing );
+      }
+
+      auto login = std::make_shared<login_api>( app1 );
+      BOOST_REQUIRE( login->login( "", "" ) );
+      graphene::wallet::wallet_data wdata;
+      wdata.chain_id = db1->get_chain_id();
+      graphene::wallet::wallet_api wallet( wdata, fc::api<login_api>( login ) );
+      wallet.set_wallet_filename( ( wallet_dir.path() / "wallet.json" ).generic_string() );
+      wallet.set_password( "password" );
+      wallet.unlock( "password" );
+      BOOST_REQUIRE( wallet.import_key( "nathan", graphene::utilities::key_to_wif( nathan_key ) ) );
+
+      auto transfer_tx = [&]( int64_t amount ) {
+         transfer_operation xfer_op;
+         xfer_op.from = nathan_id;
+         xfer_op.to = GRAPHENE_NULL_ACCOUNT;
+         xfer_op.amount = asset( amount );
+         signed_transaction trx;
+         trx.operations.push_back( xfer_op );
+         db1->current_fee_schedule().set_fee( trx.operations.back() );
+         return trx;
+      };
+      auto null_balance = [&]() { return db1->get_balance( GRAPHENE_NULL_ACCOUNT, asset_id_type() ).amount.value; };
+      int64_t null_before = null_balance();
+
+      BOOST_TEST_MESSAGE( "Signing and broadcasting a batch against one reference block" );
+      auto signed_txs = wallet.sign_transactions( { transfer_tx(1), transfer_tx(2), transfer_tx(3) }, true );
+      BOOST_REQUIRE_EQUAL( signed_txs.size(), 3u );
+      for( const auto& trx : signed_txs )
+      {
+         BOOST_CHECK_EQUAL( trx.signatures.size(), 1u );
+         BOOST_CHECK_EQUAL( trx.ref_block_num, signed_txs[0].ref_block_num );
+         BOOST_CHECK_EQUAL( trx.ref_block_prefix, signed_txs[0].ref_block_prefix );
+      }
+      BOOST_CHECK_EQUAL( null_balance(), null_before + 6 );
+
+      BOOST_TEST_MESSAGE( "Changing the active key behind the wallet's cache" );
+      // no block is produced, so no update reaches the wallet and its cached authority is stale
+      account_update_operation update_op;
+      update_op.account = nathan_id;
+      update_op.active = authority( 1, public_key_type( nathan_new_key.get_public_key() ), 1 );
+      signed_transaction update_trx;
+      update_trx.operations.push_back( update_op );
+      push_signed( update_trx );
+      BOOST_REQUIRE( wallet.import_key( "nathan", graphene::utilities::key_to_wif( nathan_new_key ) ) );
+
+      // signed with the cached key the broadcast fails, which drops the cached authority
+      BOOST_CHECK_THROW( wallet.sign_transactions( { transfer_tx(4) }, true ), fc::exception );
+      BOOST_CHECK_EQUAL( null_balance(), null_before + 6 );
+      auto retried = wallet.sign_transactions( { transfer_tx(4) }, true );
+      BOOST_CHECK_EQUAL( retried.front().signatures.size(), 1u );
+      BOOST_CHECK_EQUAL( null_balance(), null_before + 10 );
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
@@ -118,6 +118,46 @@ BOOST_AUTO_TEST_CASE(subject_basic_test)
 
 }
 
+BOOST_AUTO_TEST_CASE(subject_vote_by_voter_subject_index)
+{
+	try {
+		const account_object& alice = create_account("alice");
+		const account_object& bob   = create_account("bob");
+
+		auto make_vote = [&](account_id_type voter, subject_id_type subject_id) {
+			return db.create<subject_vote_object>([&](subject_vote_object& v) {
+				v.voter      = voter;
+				v.subject_id = subject_id;
+			}).id;
+		};
+
+		subject_id_type s1(1), s2(2);
+		object_id_type a1 = make_vote(alice.id, s1);
+		make_vote(bob.id, s1);
+		make_vote(alice.id, s2);
+		object_id_type a3 = make_vote(alice.id, s1);
+
+		const auto& idx = db.get_index_type<subject_vote_index>().indices().get<by_voter_subject>();
+
+		auto range = idx.equal_range(boost::make_tuple(alice.id, s1));
+		vector<object_id_type> ids;
+		for( auto itr = range.first; itr != range.second; ++itr )
+			ids.push_back(itr->id);
+		BOOST_REQUIRE_EQUAL(ids.size(), 2u);
+		BOOST_CHECK(ids[0] == a1);
+		BOOST_CHECK(ids[1] == a3);
+
+		range = idx.equal_range(boost::make_tuple(bob.id, s2));
+		BOOST_CHECK(range.first == range.second);
+
+		auto all = idx.equal_range(boost::make_tuple(alice.id));
+		BOOST_CHECK_EQUAL(std::distance(all.first, all.second), 3);
+	} catch (fc::exception& e) {
+		edump((e.to_detail_string()));
+		throw;
+	}
+}
+
 //BOOST_AUTO_TEST_CASE(subject_vote_test)
 //{
 
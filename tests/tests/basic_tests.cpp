@@ -30,6 +30,7 @@
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/chain/exceptions.hpp>
+#include <graphene/chain/word_object.hpp>
 
 #include <graphene/db/simple_index.hpp>
 
@@ -410,4 +411,46 @@ BOOST_AUTO_TEST_CASE( merkle_root )
    BOOST_CHECK( block.calculate_merkle_root() == c(dO) );
 }
 
+BOOST_AUTO_TEST_CASE( recover_signature_key_test )
+{
+   fc::ecc::private_key key = fc::ecc::private_key::regenerate( fc::sha256::hash( string( "recover" ) ) );
+   digest_type d1 = fc::sha256::hash( string( "one" ) );
+   digest_type d2 = fc::sha256::hash( string( "two" ) );
+   signature_type s1 = key.sign_compact( d1 );
+   signature_type s2 = key.sign_compact( d2 );
+
+   // cached and uncached lookups agree, and the digest is part of the key
+   BOOST_CHECK( recover_signature_key( d1, s1 ) == public_key_type( key.get_public_key() ) );
+   BOOST_CHECK( recover_signature_key( d1, s1 ) == public_key_type( key.get_public_key() ) );
+   BOOST_CHECK( recover_signature_key( d2, s2 ) == public_key_type( key.get_public_key() ) );
+   BOOST_CHECK( recover_signature_key( d2, s1 ) != public_key_type( key.get_public_key() ) );
+}
+
+BOOST_AUTO_TEST_CASE( sensitive_word_matcher_test )
+{
+   // the matcher must agree with the linear string::find scan it replaces
+   vector<string> words = { "\xe8\xb5\x8c", "abc", "bc", "b", "hers", "his", "she", "\xe8\xb5\x8c\xe5\x8d\x9a" };
+   vector<string> samples = { "", "a", "ab", "abc", "xbcx", "ushers", "this", "sh",
+                              "\xe8\xb5\x8c\xe5\x8d\x9a", "\xe5\x8d\x9a\xe8\xb5", "ahishers" };
+
+   auto linear = []( const vector<string>& w, const string& s ) {
+      for( size_t i = 0; i < w.size(); ++i )
+         if( s.find( w[i] ) != string::npos )
+            return i;
+      return sensitive_word_matcher::npos;
+   };
+   auto check = [&]( const vector<string>& w ) {
+      sensitive_word_matcher m;
+      m.compile( w );
+      for( const string& s : samples )
+         BOOST_CHECK_EQUAL( m.find( s.data(), s.data() + s.size() ), linear( w, s ) );
+   };
+
+   check( words );
+   check( vector<string>( words.rbegin(), words.rend() ) );
+   check( {} );
+   words.push_back( "" );
+   check( words );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
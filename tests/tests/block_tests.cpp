@@ -125,6 +125,116 @@ BOOST_AUTO_TEST_CASE( block_database_test )
    }
 }
 
+BOOST_AUTO_TEST_CASE( block_database_mmap_test )
+{
+   try {
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+
+      block_database bdb;
+      bdb.open( data_dir.path(), true );
+      FC_ASSERT( !bdb.last().valid() );
+      FC_ASSERT( !bdb.fetch_by_number( 1 ).valid() );
+
+      signed_block b;
+      vector<block_id_type> ids;
+      for( uint32_t i = 0; i < 5; ++i )
+      {
+         if( i > 0 ) b.previous = b.id();
+         b.witness = witness_id_type(i+1);
+         bdb.store( b.id(), b );
+         ids.push_back( b.id() );
+
+         // every lookup must see the block stored just before it
+         auto fetch = bdb.fetch_by_number( b.block_num() );
+         FC_ASSERT( fetch.valid() );
+         FC_ASSERT( fetch->witness == b.witness );
+         fetch = bdb.fetch_optional( b.id() );
+         FC_ASSERT( fetch.valid() );
+         FC_ASSERT( bdb.contains( b.id() ) );
+         FC_ASSERT( bdb.fetch_block_id( b.block_num() ) == b.id() );
+         FC_ASSERT( *bdb.last_id() == b.id() );
+      }
+
+      bdb.remove( ids.back() );
+      FC_ASSERT( !bdb.contains( ids.back() ) );
+      FC_ASSERT( *bdb.last_id() == ids[3] );
+      FC_ASSERT( bdb.last()->id() == ids[3] );
+
+      // the files written through the mapping are readable by the stream mode and vice versa
+      bdb.close();
+      bdb.open( data_dir.path() );
+      FC_ASSERT( bdb.last()->id() == ids[3] );
+      bdb.store( ids.back(), b );
+      bdb.close();
+      bdb.open( data_dir.path(), true );
+      FC_ASSERT( bdb.last()->id() == b.id() );
+      for( uint32_t i = 0; i < 5; ++i )
+      {
+         auto blk = bdb.fetch_by_number( i+1 );
+         FC_ASSERT( blk.valid() );
+         FC_ASSERT( blk->id() == ids[i] );
+      }
+
+      // removing a block inside the mapped range must be visible through the mapping
+      bdb.remove( ids.back() );
+      FC_ASSERT( !bdb.contains( ids.back() ) );
+      FC_ASSERT( *bdb.last_id() == ids[3] );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( block_cache_test )
+{
+   try {
+      block_cache cache;
+      cache.set_capacity( 3 );
+
+      signed_block b;
+      vector<block_id_type> ids;
+      for( uint32_t i = 0; i < 4; ++i )
+      {
+         if( i > 0 ) b.previous = b.id();
+         b.witness = witness_id_type(i+1);
+         cache.insert( b );
+         ids.push_back( b.id() );
+      }
+
+      // the oldest block was evicted
+      FC_ASSERT( cache.size() == 3 );
+      FC_ASSERT( !cache.fetch_by_id( ids[0] ) );
+      FC_ASSERT( !cache.fetch_by_number( 1 ) );
+
+      auto packed = cache.fetch_by_number( 4 );
+      FC_ASSERT( packed );
+      FC_ASSERT( *packed == fc::raw::pack( b ) );
+      FC_ASSERT( cache.fetch_header_by_number( 4 )->witness == b.witness );
+
+      // a lookup keeps block 2 alive, so block 3 goes next
+      FC_ASSERT( cache.fetch_by_id( ids[1] ) );
+      signed_block next;
+      next.previous = b.id();
+      cache.insert( next );
+      FC_ASSERT( cache.fetch_by_id( ids[1] ) );
+      FC_ASSERT( !cache.fetch_by_id( ids[2] ) );
+
+      // a block with the same number replaces the old one
+      signed_block fork = b;
+      fork.witness = witness_id_type(10);
+      cache.insert( fork );
+      FC_ASSERT( cache.size() == 3 );
+      FC_ASSERT( !cache.fetch_by_id( ids[3] ) );
+      FC_ASSERT( cache.fetch_header_by_number( 4 )->witness == fork.witness );
+
+      cache.remove( fork.id() );
+      FC_ASSERT( !cache.fetch_by_number( 4 ) );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_CASE( generate_empty_blocks )
 {
    try {
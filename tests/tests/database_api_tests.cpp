@@ -25,6 +25,10 @@
 #include <boost/test/unit_test.hpp>
 
 #include <graphene/app/database_api.hpp>
+#include <graphene/app/subscription_hub.hpp>
+#include <graphene/chain/token_object.hpp>
+
+#include <fc/rpc/raw_api.hpp>
 
 #include "../common/database_fixture.hpp"
 
@@ -68,4 +72,219 @@ BOOST_FIXTURE_TEST_SUITE(database_api_tests, database_fixture)
       } FC_LOG_AND_RETHROW()
   }
 
+  BOOST_AUTO_TEST_CASE(subject_votes_cursor_paging) {
+      try {
+          /***
+           * Arrange
+           */
+          const account_object& dan = create_account("dan");
+          subject_id_type subject_id(1);
+
+          vector<object_id_type> vote_ids;
+          for( int i = 0; i < 7; ++i )
+          {
+             vote_ids.push_back( db.create<subject_vote_object>([&](subject_vote_object& v) {
+                v.voter      = dan.id;
+                v.subject_id = ( i == 3 ) ? subject_id_type(2) : subject_id;
+             }).id );
+          }
+          vote_ids.erase( vote_ids.begin() + 3 );
+
+          /***
+           * Act
+           */
+          graphene::app::database_api db_api(db);
+          vector<object_id_type> seen;
+          optional<graphene::app::query_cursor> cursor;
+          uint32_t pages = 0;
+          do
+          {
+             auto page = db_api.get_subject_votes_by_subject_id_page( subject_id, cursor, 4 );
+             for( const auto& v : page.items )
+                seen.push_back( v.id );
+             cursor = page.next;
+             ++pages;
+          } while( cursor.valid() );
+
+          /***
+           * Assert
+           */
+          BOOST_CHECK_EQUAL( pages, 2u );
+          BOOST_CHECK( seen == vote_ids );
+
+          auto by_voter = db_api.get_subject_votes_by_voter_page( "dan", optional<graphene::app::query_cursor>(), 10 );
+          BOOST_CHECK_EQUAL( by_voter.items.size(), 7u );
+          BOOST_CHECK( !by_voter.next.valid() );
+
+      } FC_LOG_AND_RETHROW()
+  }
+
+  BOOST_AUTO_TEST_CASE(buy_token_detail_by_buyer_token) {
+      try {
+          const account_object& erin  = create_account("erin");
+          const account_object& frank = create_account("frank");
+          token_id_type t1 = db.create<token_object>([](token_object&){}).id;
+          token_id_type t2 = db.create<token_object>([](token_object&){}).id;
+
+          auto make_buy = [&]( account_id_type buyer, token_id_type token ) {
+             return db.create<token_buy_object>([&](token_buy_object& b) {
+                b.buyer    = buyer;
+                b.token_id = token;
+             }).id;
+          };
+          object_id_type first = make_buy( erin.id, t1 );
+          make_buy( frank.id, t1 );
+          make_buy( erin.id, t2 );
+          object_id_type second = make_buy( erin.id, t1 );
+
+          graphene::app::database_api db_api(db);
+          auto detail = db_api.get_buy_token_detail( t1, "erin" );
+          BOOST_REQUIRE_EQUAL( detail.size(), 2u );
+          BOOST_CHECK( detail[0].id == first );
+          BOOST_CHECK( detail[1].id == second );
+
+          BOOST_CHECK_EQUAL( db_api.get_buy_token_detail( t2, "frank" ).size(), 0u );
+      } FC_LOG_AND_RETHROW()
+  }
+
+  BOOST_AUTO_TEST_CASE(buy_list_cursor_paging) {
+      try {
+          const account_object& erin  = create_account("erin");
+          const account_object& frank = create_account("frank");
+          auto make_token = [&]() {
+             return db.create<token_object>([&](token_object& t) {
+                t.issuer = erin.id;
+                t.result.is_succeed = true;
+             }).id;
+          };
+          token_id_type t1 = make_token();
+          token_id_type t2 = make_token();
+
+          vector<object_id_type> buy_ids;
+          for( int i = 0; i < 6; ++i )
+          {
+             auto id = db.create<token_buy_object>([&](token_buy_object& b) {
+                b.buyer    = frank.id;
+                b.token_id = ( i == 2 ) ? t2 : t1;
+             }).id;
+             if( i != 2 )
+                buy_ids.push_back( id );
+          }
+
+          graphene::app::database_api db_api(db);
+          vector<object_id_type> seen;
+          optional<graphene::app::query_cursor> cursor;
+          uint32_t pages = 0;
+          do
+          {
+             auto page = db_api.get_buy_list_page( t1, "erin", cursor, 2 );
+             BOOST_REQUIRE( !page.items.empty() );
+             for( const auto& b : page.items )
+                seen.push_back( b.id );
+             cursor = page.next;
+             ++pages;
+          } while( cursor.valid() );
+
+          BOOST_CHECK_EQUAL( pages, 3u );
+          BOOST_CHECK( seen == buy_ids );
+
+          // the offset query keeps its own walk
+          auto legacy = db_api.get_buy_list( 1, 2, t1, "erin" );
+          BOOST_REQUIRE_EQUAL( legacy.size(), 2u );
+          BOOST_CHECK( legacy[0].id == buy_ids[1] );
+          BOOST_CHECK( legacy[1].id == buy_ids[2] );
+      } FC_LOG_AND_RETHROW()
+  }
+
+  BOOST_AUTO_TEST_CASE(subscription_hub_dispatch) {
+      try {
+          ACTORS( (alice)(bob)(carol) );
+          fund( alice );
+          generate_block();
+
+          auto hub = graphene::app::subscription_hub::get( db );
+          BOOST_CHECK( hub == graphene::app::subscription_hub::get( db ) );
+
+          vector<fc::variants> by_account, by_type, by_object, idle;
+          auto collect = []( vector<fc::variants>& into ) {
+             return [&into]( const fc::variant& v ) { into.push_back( v.get_array() ); };
+          };
+          auto account_sub = hub->add_subscriber( collect( by_account ), false );
+          auto type_sub    = hub->add_subscriber( collect( by_type ), false );
+          auto object_sub  = hub->add_subscriber( collect( by_object ), false );
+          auto idle_sub    = hub->add_subscriber( collect( idle ), false );
+          hub->subscribe_to_account( account_sub, bob_id );
+          hub->subscribe_to_object_type( type_sub, implementation_ids, impl_account_balance_object_type );
+          hub->subscribe_to_object( object_sub, carol_id );
+          hub->subscribe_to_account( idle_sub, carol_id );
+
+          transfer( alice, bob, asset(1000) );
+          generate_block();
+          fc::usleep( fc::milliseconds(10) );
+
+          // one coalesced update per block for each interested subscriber
+          BOOST_REQUIRE_EQUAL( by_account.size(), 1u );
+          BOOST_REQUIRE_EQUAL( by_type.size(), 1u );
+          BOOST_CHECK( by_object.empty() );
+          BOOST_CHECK( idle.empty() );
+          for( const auto& update : by_type[0] )
+             BOOST_CHECK( update["id"].as<object_id_type>().is<account_balance_id_type>() );
+          BOOST_CHECK_GE( by_type[0].size(), 2u );
+
+          hub->remove_subscriber( account_sub );
+          hub->remove_subscriber( type_sub );
+          transfer( alice, bob, asset(1000) );
+          generate_block();
+          fc::usleep( fc::milliseconds(10) );
+          BOOST_CHECK_EQUAL( by_account.size(), 1u );
+          BOOST_CHECK_EQUAL( by_type.size(), 1u );
+
+          // single object subscriptions are capped per subscriber
+          for( uint64_t i = 0; i < graphene::app::subscription_hub::max_object_subscriptions - 1; ++i )
+             BOOST_CHECK( hub->subscribe_to_object( object_sub, account_id_type( 1000 + i ) ) );
+          BOOST_CHECK( hub->subscribe_to_object( object_sub, carol_id ) );
+          BOOST_CHECK( !hub->subscribe_to_object( object_sub, account_id_type( 999999 ) ) );
+          BOOST_CHECK( !hub->is_subscribed_to_object( object_sub, account_id_type( 999999 ) ) );
+          BOOST_CHECK( hub->subscribe_to_object( idle_sub, account_id_type( 999999 ) ) );
+
+          hub->remove_subscriber( object_sub );
+          hub->remove_subscriber( idle_sub );
+          BOOST_CHECK_EQUAL( hub->subscriber_count(), 0u );
+      } FC_LOG_AND_RETHROW()
+  }
+
+  BOOST_AUTO_TEST_CASE(raw_api_calls) {
+      try {
+          ACTORS( (alice) );
+
+          auto db_api = std::make_shared<graphene::app::database_api>( std::ref( db ) );
+          fc::rpc::raw_api raw{ fc::api<graphene::app::database_api>( db_api ) };
+          BOOST_CHECK( raw.has_method( "get_full_accounts" ) );
+          // callbacks need the JSON protocol
+          BOOST_CHECK( !raw.has_method( "set_subscribe_callback" ) );
+
+          auto call = [&]( const string& method, const vector<char>& args ) {
+             fc::datastream<const char*> ds( args.data(), args.size() );
+             std::string frame;
+             raw.call( method, ds, frame );
+             return vector<char>( frame.begin(), frame.end() );
+          };
+
+          auto accounts = fc::raw::unpack< vector<optional<account_object>> >(
+                             call( "get_accounts", fc::raw::pack( vector<account_id_type>{ alice_id } ) ) );
+          BOOST_REQUIRE_EQUAL( accounts.size(), 1u );
+          BOOST_REQUIRE( accounts[0].valid() );
+          BOOST_CHECK_EQUAL( accounts[0]->name, "alice" );
+
+          // arguments are packed one after the other
+          vector<char> args = fc::raw::pack( string( "alice" ) );
+          auto limit = fc::raw::pack( uint32_t( 10 ) );
+          args.insert( args.end(), limit.begin(), limit.end() );
+          auto found = fc::raw::unpack< map<string,account_id_type> >( call( "lookup_accounts", args ) );
+          BOOST_CHECK( found.at( "alice" ) == alice_id );
+
+          GRAPHENE_CHECK_THROW( call( "no_such_method", vector<char>() ), fc::exception );
+      } FC_LOG_AND_RETHROW()
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
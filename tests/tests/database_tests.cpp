@@ -27,8 +27,13 @@
 #include <graphene/chain/database.hpp>
 
 #include <graphene/chain/account_object.hpp>
+#include <graphene/chain/coin_object.hpp>
+#include <graphene/chain/hardfork.hpp>
+#include <graphene/utilities/tempdir.hpp>
 
 #include <fc/crypto/digest.hpp>
+#include <fc/filesystem.hpp>
+
 
 #include "../common/database_fixture.hpp"
 
@@ -59,3 +64,320 @@ BOOST_AUTO_TEST_CASE( undo_test )
       throw;
    }
 }
+
+BOOST_AUTO_TEST_CASE( undo_recycled_copies_test )
+{
+   try {
+      database db;
+      const auto& bal = db.create<account_balance_object>( [&]( account_balance_object& obj ){
+         obj.balance = 1;
+      });
+      account_balance_id_type id = bal.id;
+      db._undo_db.enable();
+
+      // later sessions take their copies from the ones discarded before
+      for( int i = 0; i < 3; ++i )
+      {
+         auto ses = db._undo_db.start_undo_session();
+         db.modify( id(db), [&]( account_balance_object& obj ){ obj.balance = 10 + i; } );
+         auto inner = db._undo_db.start_undo_session();
+         db.modify( id(db), [&]( account_balance_object& obj ){ obj.balance = 20 + i; } );
+         inner.merge();
+         BOOST_CHECK_EQUAL( id(db).balance.value, 20 + i );
+         ses.undo();
+         BOOST_CHECK_EQUAL( id(db).balance.value, 1 );
+      }
+
+      {
+         auto ses = db._undo_db.start_undo_session();
+         db.modify( id(db), [&]( account_balance_object& obj ){ obj.balance = 5; } );
+         db.remove( id(db) );
+         BOOST_CHECK( db.find( id ) == nullptr );
+         ses.undo();
+      }
+      BOOST_CHECK_EQUAL( id(db).balance.value, 1 );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( index_snapshot_test )
+{
+   try {
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+      fc::path file = data_dir.path() / "balances";
+      typedef graphene::db::primary_index<account_balance_index> balance_index;
+
+      graphene::db::object_database db;
+      auto* idx = db.add_index<balance_index>();
+      for( int64_t i = 0; i < 3; ++i )
+         db.create<account_balance_object>( [&]( account_balance_object& obj ){
+            obj.owner   = account_id_type( i );
+            obj.balance = i * 100;
+         });
+      idx->save( file );
+
+      graphene::db::object_database db2;
+      auto* idx2 = db2.add_index<balance_index>();
+      idx2->open( file );
+      BOOST_CHECK( idx2->get_next_id() == idx->get_next_id() );
+      const auto& loaded = idx2->indices().get<by_id>();
+      BOOST_REQUIRE_EQUAL( loaded.size(), 3u );
+      BOOST_CHECK( loaded.rbegin()->owner == account_id_type( 2 ) );
+      BOOST_CHECK( loaded.rbegin()->balance == 200 );
+
+      // a flipped byte anywhere before the trailing checksum is rejected
+      {
+         std::fstream f( file.generic_string(), std::ios::in | std::ios::out | std::ios::binary );
+         f.seekp( fc::file_size( file ) - sizeof(fc::sha256) - 1 );
+         f.put( 0x7f );
+      }
+      graphene::db::object_database db3;
+      auto* idx3 = db3.add_index<balance_index>();
+      GRAPHENE_REQUIRE_THROW( idx3->open( file ), fc::exception );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( index_dirty_flush_test )
+{
+   try {
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+      fc::path file = data_dir.path() / "balances";
+
+      graphene::db::object_database db;
+      auto* idx = db.add_index< graphene::db::primary_index<account_balance_index> >();
+      const auto& bal = db.create<account_balance_object>( [&]( account_balance_object& obj ){
+         obj.balance = 1;
+      });
+      idx->save( file );
+      uint64_t saved_size = fc::file_size( file );
+
+      // a clean index leaves the file alone
+      {
+         std::ofstream f( file.generic_string(), std::ios::app | std::ios::binary );
+         f.put( 0 );
+      }
+      idx->save( file );
+      BOOST_CHECK_EQUAL( fc::file_size( file ), saved_size + 1 );
+
+      // any change rewrites it
+      db.modify( bal, [&]( account_balance_object& obj ){ obj.balance = 2; } );
+      idx->save( file );
+      BOOST_CHECK_EQUAL( fc::file_size( file ), saved_size );
+      BOOST_CHECK( !fc::exists( file.generic_string() + ".tmp" ) );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( coin_price_compaction_test, database_fixture )
+{
+   try {
+      const uint32_t day = PRICE_DATA_DIVIDE_INTERVAL;
+      const auto& day0 = db.create<coin_price_data_object>( [&]( coin_price_data_object& obj ){
+         obj.price_feeding[60].price = 100;
+         obj.price_feeding[120].price = INVALID_FEED_PRICE;
+         obj.price_feeding[3600 + 180].price = 300;
+      });
+      coin_price_data_id_type day0_id = day0.id;
+      const auto& day1 = db.create<coin_price_data_object>( [&]( coin_price_data_object& obj ){
+         obj.price_feeding[day + 60].price = 400;
+      });
+      const auto& dyn = db.create<coin_dynamic_data_object>( [&]( coin_dynamic_data_object& obj ){
+         obj.prices[0] = day0.id;
+         obj.prices[day] = day1.id;
+         obj.latest_feed_time = day + 60;
+      });
+      const auto& fixed = db.create<coin_fixed_data_object>( [&]( coin_fixed_data_object& obj ){
+         obj.price_fixed[240].price = 200;
+      });
+      const auto& coin = db.create<coin_object>( [&]( coin_object& obj ){
+         obj.platform_quote_base = "1000001:BTC/USD";
+         obj.dynamic_coin_data_id = dyn.id;
+         obj.fixed_coin_data_id = fixed.id;
+         obj.feeders.insert( account_id_type() );
+      });
+
+      db.compact_coin_prices();
+
+      // only the day still being fed keeps its detail
+      BOOST_CHECK( fixed.price_fixed.empty() );
+      BOOST_CHECK_EQUAL( dyn.prices.size(), 1u );
+      BOOST_CHECK( dyn.prices.count( day ) );
+      BOOST_CHECK( db.find( day0_id ) == nullptr );
+      BOOST_CHECK( db.find_object( day1.id ) != nullptr );
+
+      BOOST_CHECK_EQUAL( db.get_index_type<coin_price_bucket_index>().indices().size(), 2u );
+      BOOST_CHECK_EQUAL( db.find_compacted_coin_price( coin.id, 60 )->value, 100 );
+      BOOST_CHECK_EQUAL( db.find_compacted_coin_price( coin.id, 240 )->value, 200 );
+      BOOST_CHECK_EQUAL( db.find_compacted_coin_price( coin.id, 3600 + 180 )->value, 300 );
+      BOOST_CHECK( !db.find_compacted_coin_price( coin.id, 120 ).valid() );
+      BOOST_CHECK( !db.find_compacted_coin_price( coin.id, day + 60 ).valid() );
+
+      // feeds for compacted days are only refused once compaction is live
+      BOOST_CHECK( !db.is_coin_price_compacted( coin, 60 ) );
+      generate_blocks( HARDFORK_COIN_PRICE_BUCKET_TIME );
+      BOOST_CHECK( db.is_coin_price_compacted( coin, 60 ) );
+      BOOST_CHECK( !db.is_coin_price_compacted( coin, day + 120 ) );
+
+      // a single feed goes through the same check as the batch
+      coin_feed_price_operation op;
+      op.publisher = account_id_type();
+      op.coin_id = coin.id;
+      op.platform_id = "1000001";
+      op.quote_base = "BTC/USD";
+      op.prices[60] = 100;
+      trx.operations.push_back( op );
+      test::set_expiration( db, trx );
+      bool refused = false;
+      try {
+         PUSH_TX( db, trx, ~0 );
+      } catch( const fc::exception& e ) {
+         refused = e.to_detail_string().find( "already compacted" ) != string::npos;
+      }
+      BOOST_CHECK( refused );
+      BOOST_CHECK_EQUAL( db.find_compacted_coin_price( coin.id, 60 )->value, 100 );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( performance_stats_test, database_fixture )
+{
+   try {
+      latency_histogram h;
+      h.record( 0 );
+      h.record( 1 );
+      h.record( 1000 );
+      h.record( int64_t(1) << 40 );
+      BOOST_CHECK_EQUAL( h.count, 4u );
+      BOOST_CHECK_EQUAL( h.buckets[0], 1u );
+      BOOST_CHECK_EQUAL( h.buckets[1], 1u );
+      BOOST_CHECK_EQUAL( h.buckets[10], 1u );
+      BOOST_CHECK_EQUAL( h.buckets[latency_histogram::bucket_count - 1], 1u );
+      BOOST_CHECK_EQUAL( operation_type_name( operation::tag<transfer_operation>::value ), "transfer_operation" );
+
+      ACTORS( (alice)(bob) );
+      fund( alice );
+      db.reset_performance_stats();
+      transfer( alice, bob, asset(1000) );
+
+      // pending transactions and block generation are not recorded, only applying the block is
+      const auto& stats = db.get_performance_stats();
+      const auto& t = stats.operations[ operation::tag<transfer_operation>::value ];
+      BOOST_CHECK_EQUAL( t.evaluate.count, 0u );
+      generate_block();
+
+      BOOST_CHECK_EQUAL( t.evaluate.count, 1u );
+      BOOST_CHECK_EQUAL( t.apply.count, 1u );
+      BOOST_CHECK_GT( t.undo_entries, 0u );
+      BOOST_CHECK_EQUAL( stats.blocks.total.count, 1u );
+      BOOST_CHECK_EQUAL( stats.blocks.transactions.count, 1u );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( asset_holder_index_test, database_fixture )
+{
+   try {
+      ACTORS( (alice)(bob)(carol) );
+      const auto& holders = dynamic_cast<const primary_index<account_balance_index>&>(
+                               db.get_index_type<account_balance_index>() ).get_secondary_index<asset_holder_index>();
+      uint32_t before = holders.holder_count( asset_id_type() );
+
+      transfer( committee_account, alice_id, asset(300) );
+      transfer( committee_account, bob_id, asset(200) );
+      transfer( committee_account, carol_id, asset(100) );
+      BOOST_CHECK_EQUAL( holders.holder_count( asset_id_type() ), before + 3 );
+
+      // ranked by balance, largest first, and pages line up with the full ranking
+      auto all = holders.get_holders( asset_id_type(), 0, before + 3 );
+      BOOST_REQUIRE_EQUAL( all.size(), before + 3 );
+      for( size_t i = 1; i < all.size(); ++i )
+         BOOST_CHECK( all[i-1].balance >= all[i].balance );
+      auto rank_of = [&]( account_id_type a ) {
+         return std::find_if( all.begin(), all.end(), [&]( const asset_holder_index::holder& h ) { return h.owner == a; } ) - all.begin();
+      };
+      BOOST_CHECK( rank_of( alice_id ) < rank_of( bob_id ) );
+      BOOST_CHECK( rank_of( bob_id ) < rank_of( carol_id ) );
+      auto page = holders.get_holders( asset_id_type(), rank_of( bob_id ), 2 );
+      BOOST_REQUIRE_EQUAL( page.size(), 2u );
+      BOOST_CHECK( page[0].owner == bob_id && page[0].balance == 200 );
+      BOOST_CHECK( page[1].owner == all[rank_of( bob_id ) + 1].owner );
+      BOOST_CHECK( holders.get_holders( asset_id_type(), before + 3, 10 ).empty() );
+
+      // emptying a balance removes the holder, undo restores it
+      {
+         auto session = db._undo_db.start_undo_session();
+         db.adjust_balance( carol_id, -asset(100) );
+         BOOST_CHECK_EQUAL( holders.holder_count( asset_id_type() ), before + 2 );
+      }
+      BOOST_CHECK_EQUAL( holders.holder_count( asset_id_type() ), before + 3 );
+      BOOST_CHECK( holders.get_holders( asset_id_type(), rank_of( carol_id ), 1 )[0].owner == carol_id );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( read_worker_threads_test, database_fixture )
+{
+   try {
+      ACTORS( (alice) );
+      transfer( committee_account, alice_id, asset(500) );
+
+      // inline until workers are configured
+      BOOST_CHECK( db.with_read_access( []() { return &fc::thread::current(); } ) == &fc::thread::current() );
+
+      db.set_read_worker_threads( 2 );
+      BOOST_CHECK( db.with_read_access( []() { return &fc::thread::current(); } ) != &fc::thread::current() );
+      BOOST_CHECK_EQUAL( db.with_read_access( [&]() { return db.get_balance( alice_id, asset_id_type() ).amount.value; } ), 500 );
+      BOOST_CHECK_THROW( db.with_read_access( [&]() { return db.get( account_id_type(999999) ).name; } ), fc::exception );
+
+      generate_block();
+      transfer( alice_id, committee_account, asset(100) );
+      generate_block();
+      BOOST_CHECK_EQUAL( db.with_read_access( [&]() { return db.get_balance( alice_id, asset_id_type() ).amount.value; } ), 400 );
+
+      // a write waits for a running reader without blocking the main thread, and the reader sees the old state
+      fc::promise<void>::ptr reader_in( new fc::promise<void>( "reader_in" ) );
+      fc::promise<void>::ptr release_reader( new fc::promise<void>( "release_reader" ) );
+      auto slow_read = fc::async( [&]() {
+         return db.with_read_access( [&]() {
+            reader_in->set_value();
+            fc::future<void>( release_reader ).wait();
+            return db.get_balance( alice_id, asset_id_type() ).amount.value;
+         });
+      });
+      fc::future<void>( reader_in ).wait();
+      // runs while the transfer below waits for the reader
+      int64_t balance_while_writing = 0;
+      fc::async( [&]() {
+         balance_while_writing = db.get_balance( alice_id, asset_id_type() ).amount.value;
+         release_reader->set_value();
+      });
+      transfer( alice_id, committee_account, asset(100) );
+      BOOST_CHECK_EQUAL( balance_while_writing, 400 );
+      BOOST_CHECK_EQUAL( slow_read.wait(), 400 );
+      BOOST_CHECK_EQUAL( db.with_read_access( [&]() { return db.get_balance( alice_id, asset_id_type() ).amount.value; } ), 300 );
+      db.set_read_worker_threads( 0 );
+   } catch ( const fc::exception& e )
+   {
+      edump( (e.to_detail_string()) );
+      throw;
+   }
+}
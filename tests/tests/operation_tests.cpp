@@ -30,6 +30,7 @@
 
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/coin_object.hpp>
 #include <graphene/chain/committee_member_object.hpp>
 #include <graphene/chain/market_object.hpp>
 #include <graphene/chain/vesting_balance_object.hpp>
@@ -1260,6 +1261,177 @@ BOOST_AUTO_TEST_CASE( fill_order )
    //o.calculate_fee(db.current_fee_schedule());
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( coin_feed_price_batch_validate )
+{ try {
+   coin_feed_price_batch_operation o;
+   GRAPHENE_CHECK_THROW(o.validate(), fc::exception);
+
+   coin_feed_price_batch_operation::coin_feed btc;
+   btc.coin_id = coin_id_type(1);
+   btc.prices[600] = 100;
+   coin_feed_price_batch_operation::coin_feed eth;
+   eth.coin_id = coin_id_type(2);
+   eth.prices[600] = 10;
+   eth.prices[660] = 11;
+   o.feeds = { btc, eth };
+   o.validate();
+
+   coin_feed_price_batch_operation::fee_parameters_type k;
+   BOOST_CHECK_EQUAL( o.calculate_fee( k ).value, k.fee + 2 * k.price_per_feed );
+
+   o.feeds = { eth, btc };
+   GRAPHENE_CHECK_THROW(o.validate(), fc::exception);
+   o.feeds = { btc, btc };
+   GRAPHENE_CHECK_THROW(o.validate(), fc::exception);
+   eth.prices.erase(661);
+   eth.prices[720] = INVALID_FEED_PRICE;
+   o.feeds = { btc, eth };
+   o.validate();
+   eth.prices[720] = 0;
+   o.feeds = { btc, eth };
+   GRAPHENE_CHECK_THROW(o.validate(), fc::exception);
+   eth.prices[720] = 12;
+   eth.prices[661] = 12;
+   o.feeds = { btc, eth };
+   GRAPHENE_CHECK_THROW(o.validate(), fc::exception);
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( coin_feed_price_batch_hardfork )
+{ try {
+   ACTORS( (alice) );
+
+   coin_feed_price_batch_operation feed;
+   feed.publisher = alice_id;
+   coin_feed_price_batch_operation::coin_feed btc;
+   btc.coin_id = coin_id_type(1);
+   btc.prices[600] = 100;
+   feed.feeds = { btc };
+
+   auto propose = [&]() {
+      proposal_create_operation prop;
+      prop.fee_paying_account = alice_id;
+      prop.proposed_ops.emplace_back( feed );
+      prop.expiration_time = db.head_block_time() + fc::days(1);
+      signed_transaction tx;
+      tx.operations.push_back( prop );
+      set_expiration( db, tx );
+      return tx;
+   };
+
+   // neither directly nor in a proposal before the hardfork
+   trx.operations.push_back( feed );
+   set_expiration( db, trx );
+   GRAPHENE_REQUIRE_THROW( PUSH_TX( db, trx, ~0 ), fc::exception );
+   trx.clear();
+   GRAPHENE_REQUIRE_THROW( PUSH_TX( db, propose(), ~0 ), fc::exception );
+
+   generate_blocks( HARDFORK_COIN_FEED_BATCH_TIME );
+   generate_block();
+   PUSH_TX( db, propose(), ~0 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( coin_feed_price_batch_apply )
+{ try {
+   ACTORS( (alice)(bob) );
+   generate_blocks( HARDFORK_COIN_FEED_BATCH_TIME );
+   generate_block();
+
+   auto make_coin = [&]( const string& platform_quote_base ) {
+      const auto& fixed = db.create<coin_fixed_data_object>( []( coin_fixed_data_object& ){} );
+      const auto& dyn = db.create<coin_dynamic_data_object>( []( coin_dynamic_data_object& ){} );
+      return db.create<coin_object>( [&]( coin_object& c ){
+         c.platform_quote_base = platform_quote_base;
+         c.fixed_coin_data_id = fixed.id;
+         c.dynamic_coin_data_id = dyn.id;
+         c.feeders.insert( alice_id );
+      }).id;
+   };
+   // the same prices go to one coin by batch and to the other by coin_feed_price_operation
+   coin_id_type batched = make_coin( "1000001:BTC/USD" );
+   coin_id_type single  = make_coin( "1000001:ETH/USD" );
+
+   auto push = [&]( const operation& op ) {
+      signed_transaction tx;
+      tx.operations.push_back( op );
+      set_expiration( db, tx );
+      PUSH_TX( db, tx, ~0 );
+   };
+   auto feed_both = [&]( const map<uint32_t, share_type>& prices, bool reset_price ) {
+      coin_feed_price_batch_operation batch;
+      batch.publisher = alice_id;
+      coin_feed_price_batch_operation::coin_feed feed;
+      feed.coin_id = batched;
+      feed.prices = prices;
+      feed.reset_price = reset_price;
+      batch.feeds = { feed };
+      push( batch );
+
+      coin_feed_price_operation op;
+      op.publisher = alice_id;
+      op.coin_id = single;
+      op.platform_id = "1000001";
+      op.quote_base = "ETH/USD";
+      op.prices = prices;
+      op.reset_price = reset_price;
+      push( op );
+   };
+   auto check_same = [&]() {
+      const auto& a = batched( db ).dynamic_data( db );
+      const auto& b = single( db ).dynamic_data( db );
+      BOOST_CHECK_EQUAL( a.latest_feed_time, b.latest_feed_time );
+      BOOST_CHECK_EQUAL( a.latest_valid_time, b.latest_valid_time );
+      BOOST_CHECK_EQUAL( a.latest_valid_price.price.value, b.latest_valid_price.price.value );
+      BOOST_CHECK_EQUAL( a.invalid_price_count, b.invalid_price_count );
+      BOOST_REQUIRE_EQUAL( a.prices.size(), b.prices.size() );
+      for( auto ia = a.prices.begin(), ib = b.prices.begin(); ia != a.prices.end(); ++ia, ++ib )
+      {
+         BOOST_CHECK_EQUAL( ia->first, ib->first );
+         const auto& fa = ia->second( db ).price_feeding;
+         const auto& fb = ib->second( db ).price_feeding;
+         BOOST_REQUIRE_EQUAL( fa.size(), fb.size() );
+         for( auto pa = fa.begin(), pb = fb.begin(); pa != fa.end(); ++pa, ++pb )
+         {
+            BOOST_CHECK_EQUAL( pa->first, pb->first );
+            BOOST_CHECK_EQUAL( pa->second.price.value, pb->second.price.value );
+            BOOST_CHECK_EQUAL( pa->second.total_feed_count.value, pb->second.total_feed_count.value );
+            BOOST_CHECK( pa->second.price_detail == pb->second.price_detail );
+         }
+      }
+   };
+
+   feed_both( { { 600, 100 }, { 660, INVALID_FEED_PRICE }, { 720, 120 } }, false );
+   BOOST_CHECK_EQUAL( batched( db ).dynamic_data( db ).latest_feed_time, 720u );
+   check_same();
+
+   coin_feed_price_batch_operation batch;
+   coin_feed_price_batch_operation::coin_feed feed;
+   feed.coin_id = batched;
+
+   // only feeders of the coin
+   batch.publisher = bob_id;
+   feed.prices = { { 780, 130 } };
+   batch.feeds = { feed };
+   GRAPHENE_REQUIRE_THROW( push( batch ), fc::exception );
+
+   // gap after the latest feed, and a gap inside the feed
+   batch.publisher = alice_id;
+   feed.prices = { { 840, 130 } };
+   batch.feeds = { feed };
+   GRAPHENE_REQUIRE_THROW( push( batch ), coin_feed_price_not_continuous );
+   feed.prices = { { 780, 130 }, { 900, 140 } };
+   batch.feeds = { feed };
+   GRAPHENE_REQUIRE_THROW( push( batch ), coin_feed_price_not_continuous );
+   check_same();
+
+   // reset_price skips the continuity check
+   feed_both( { { 840, 130 } }, true );
+   BOOST_CHECK_EQUAL( batched( db ).dynamic_data( db ).latest_feed_time, 840u );
+   check_same();
+
+   generate_block();
+   check_same();
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE( witness_pay_test )
 { try {
 
@@ -25,7 +25,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include <graphene/chain/database.hpp>
-
+#include <graphene/net/core_messages.hpp>
+#include <graphene/net/message.hpp>
 
 #include <fc/crypto/digest.hpp>
 #include <fc/crypto/elliptic.hpp>
@@ -148,4 +149,41 @@ BOOST_AUTO_TEST_CASE( extension_serialization_test )
    }
 }
 
+BOOST_AUTO_TEST_CASE( compact_block_message_test )
+{
+   try
+   {
+      ACTORS( (alice)(bob) );
+      fund( alice );
+      transfer( alice, bob, asset(100) );
+      transfer( alice, bob, asset(200) );
+      signed_block b = generate_block();
+      BOOST_REQUIRE_EQUAL( b.transactions.size(), 2u );
+
+      graphene::net::block_message full( b );
+      graphene::net::message full_message( full );
+      graphene::net::compact_block_message compact( full, full_message.id() );
+      BOOST_CHECK_EQUAL( compact.transactions.size(), 2u );
+      BOOST_CHECK( compact.transactions[1].id == b.transactions[1].id() );
+
+      // the receiver rebuilds the same message from transactions it holds and the results in the compact block
+      auto unpacked = fc::raw::unpack<graphene::net::compact_block_message>( fc::raw::pack( compact ) );
+      graphene::net::block_message rebuilt;
+      rebuilt.block_id = unpacked.block_id;
+      static_cast<signed_block_header&>( rebuilt.block ) = unpacked.header;
+      for( size_t i = 0; i < unpacked.transactions.size(); ++i )
+      {
+         rebuilt.block.transactions.emplace_back( signed_transaction( b.transactions[i] ) );
+         rebuilt.block.transactions.back().operation_results = unpacked.transactions[i].operation_results;
+      }
+      BOOST_CHECK( graphene::net::message( rebuilt ).id() == unpacked.block_message_hash );
+      BOOST_CHECK_LT( fc::raw::pack_size( compact ), fc::raw::pack_size( full ) );
+   }
+   catch ( const fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()